@@ -8,7 +8,18 @@ public class Fusion : ModuleRules
 	
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "AudioMixer", "AudioCapture", "Slate", "SlateCore", "UMG" });
 
-		PrivateDependencyModuleNames.AddRange(new string[] { "HTTP", "Json", "JsonUtilities", "WebSockets" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "HTTP", "Json", "JsonUtilities", "WebSockets", "Sockets", "Networking" });
+
+		// In-process gesture/AI stand-in servers (FusionMockBackend) for development and load testing.
+		if (Target.Configuration != UnrealTargetConfiguration.Shipping)
+		{
+			PrivateDependencyModuleNames.AddRange(new string[] { "HTTPServer", "WebSocketNetworking" });
+			PublicDefinitions.Add("WITH_FUSION_MOCK_BACKEND=1");
+		}
+		else
+		{
+			PublicDefinitions.Add("WITH_FUSION_MOCK_BACKEND=0");
+		}
 
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
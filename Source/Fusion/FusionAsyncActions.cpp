@@ -0,0 +1,135 @@
+#include "FusionAsyncActions.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+    AFusionMode* FindFusionMode(UObject* WorldContextObject)
+    {
+        UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+        return World ? World->GetAuthGameMode<AFusionMode>() : nullptr;
+    }
+}
+
+UFusionDescriptionAsyncAction* UFusionDescriptionAsyncAction::RequestObjectDescriptionAsync(UObject* WorldContextObject, const FString& ObjectId, bool bPrefetch)
+{
+    UFusionDescriptionAsyncAction* Action = NewObject<UFusionDescriptionAsyncAction>();
+    Action->WorldContext = WorldContextObject;
+    Action->ObjectId = ObjectId;
+    Action->bPrefetch = bPrefetch;
+    Action->RegisterWithGameInstance(WorldContextObject);
+    return Action;
+}
+
+void UFusionDescriptionAsyncAction::Activate()
+{
+    AFusionMode* FusionMode = FindFusionMode(WorldContext.Get());
+    if (!FusionMode)
+    {
+        FFusionDescriptionResult Result;
+        Result.ObjectId = ObjectId;
+        Finish(Result);
+        return;
+    }
+
+    CancellationToken = MakeShared<FFusionCancellationToken, ESPMode::ThreadSafe>();
+    const EFusionRequestPriority Priority = bPrefetch ? EFusionRequestPriority::Speculative : EFusionRequestPriority::Description;
+
+    TWeakObjectPtr<UFusionDescriptionAsyncAction> WeakThis = this;
+    FusionMode->RequestObjectDescriptionAsync(ObjectId, Priority, CancellationToken).Next([WeakThis](const FFusionDescriptionResult& Result)
+    {
+        if (UFusionDescriptionAsyncAction* StrongThis = WeakThis.Get())
+        {
+            StrongThis->Finish(Result);
+        }
+    });
+}
+
+void UFusionDescriptionAsyncAction::Cancel()
+{
+    Super::Cancel();
+
+    if (CancellationToken.IsValid())
+    {
+        CancellationToken->Cancel();
+    }
+}
+
+void UFusionDescriptionAsyncAction::Finish(const FFusionDescriptionResult& Result)
+{
+    if (!ShouldBroadcastDelegates())
+    {
+        return;
+    }
+
+    if (Result.IsSuccess())
+    {
+        Completed.Broadcast(Result);
+    }
+    else
+    {
+        Failed.Broadcast(Result);
+    }
+    SetReadyToDestroy();
+}
+
+UFusionVoiceQueryAsyncAction* UFusionVoiceQueryAsyncAction::SendVoiceQueryAsync(UObject* WorldContextObject, const FString& FilePath)
+{
+    UFusionVoiceQueryAsyncAction* Action = NewObject<UFusionVoiceQueryAsyncAction>();
+    Action->WorldContext = WorldContextObject;
+    Action->FilePath = FilePath;
+    Action->RegisterWithGameInstance(WorldContextObject);
+    return Action;
+}
+
+void UFusionVoiceQueryAsyncAction::Activate()
+{
+    AFusionMode* FusionMode = FindFusionMode(WorldContext.Get());
+    TArray<uint8> WavData;
+    if (!FusionMode || !FFileHelper::LoadFileToArray(WavData, *FilePath))
+    {
+        Finish(FFusionVoiceAnswerResult());
+        return;
+    }
+
+    CancellationToken = MakeShared<FFusionCancellationToken, ESPMode::ThreadSafe>();
+
+    TWeakObjectPtr<UFusionVoiceQueryAsyncAction> WeakThis = this;
+    FusionMode->SendVoiceQueryAsync(MoveTemp(WavData), CancellationToken).Next([WeakThis](const FFusionVoiceAnswerResult& Result)
+    {
+        if (UFusionVoiceQueryAsyncAction* StrongThis = WeakThis.Get())
+        {
+            StrongThis->Finish(Result);
+        }
+    });
+}
+
+void UFusionVoiceQueryAsyncAction::Cancel()
+{
+    Super::Cancel();
+
+    if (CancellationToken.IsValid())
+    {
+        CancellationToken->Cancel();
+    }
+}
+
+void UFusionVoiceQueryAsyncAction::Finish(const FFusionVoiceAnswerResult& Result)
+{
+    if (!ShouldBroadcastDelegates())
+    {
+        return;
+    }
+
+    if (Result.IsSuccess())
+    {
+        Completed.Broadcast(Result);
+    }
+    else
+    {
+        Failed.Broadcast(Result);
+    }
+    SetReadyToDestroy();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "FusionMode.h"
+#include "FusionAsyncActions.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FFusionDescriptionAsyncPin, const FFusionDescriptionResult&, Result);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FFusionVoiceAnswerAsyncPin, const FFusionVoiceAnswerResult&, Result);
+
+/** Latent Blueprint node around AFusionMode::RequestObjectDescriptionAsync. */
+UCLASS()
+class FUSION_API UFusionDescriptionAsyncAction : public UCancellableAsyncAction
+{
+    GENERATED_BODY()
+
+public:
+    /** Requests a description from the current AFusionMode; Completed also fires for answers served from the cache. */
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Networking", meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"))
+    static UFusionDescriptionAsyncAction* RequestObjectDescriptionAsync(UObject* WorldContextObject, const FString& ObjectId, bool bPrefetch = false);
+
+    virtual void Activate() override;
+
+    /** Drops the request; no pin fires afterwards. */
+    virtual void Cancel() override;
+
+    UPROPERTY(BlueprintAssignable)
+    FFusionDescriptionAsyncPin Completed;
+
+    UPROPERTY(BlueprintAssignable)
+    FFusionDescriptionAsyncPin Failed;
+
+private:
+    void Finish(const FFusionDescriptionResult& Result);
+
+    TWeakObjectPtr<UObject> WorldContext;
+    FString ObjectId;
+    bool bPrefetch = false;
+    TSharedPtr<FFusionCancellationToken, ESPMode::ThreadSafe> CancellationToken;
+};
+
+/** Latent Blueprint node around AFusionMode::SendVoiceQueryAsync. */
+UCLASS()
+class FUSION_API UFusionVoiceQueryAsyncAction : public UCancellableAsyncAction
+{
+    GENERATED_BODY()
+
+public:
+    /** Uploads a recorded wav file and waits for the complete answer; streamed chunks still arrive through OnVoiceAnswerChunkReceived. */
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Networking", meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"))
+    static UFusionVoiceQueryAsyncAction* SendVoiceQueryAsync(UObject* WorldContextObject, const FString& FilePath);
+
+    virtual void Activate() override;
+
+    /** Drops the query; no pin fires afterwards. */
+    virtual void Cancel() override;
+
+    UPROPERTY(BlueprintAssignable)
+    FFusionVoiceAnswerAsyncPin Completed;
+
+    UPROPERTY(BlueprintAssignable)
+    FFusionVoiceAnswerAsyncPin Failed;
+
+private:
+    void Finish(const FFusionVoiceAnswerResult& Result);
+
+    TWeakObjectPtr<UObject> WorldContext;
+    FString FilePath;
+    TSharedPtr<FFusionCancellationToken, ESPMode::ThreadSafe> CancellationToken;
+};
@@ -0,0 +1,52 @@
+#include "FusionClockSync.h"
+
+namespace
+{
+    /** Weight of a new best-exchange offset and of a new RTT in their running averages. */
+    constexpr double OffsetSmoothing = 0.25;
+    constexpr double RoundTripSmoothing = 0.125;
+}
+
+void FFusionClockSync::AddSample(double T0, double T1, double T2, double T3)
+{
+    const double RoundTrip = (T3 - T0) - (T2 - T1);
+    if (T3 < T0 || RoundTrip < 0.0)
+    {
+        return;
+    }
+
+    FSample& Sample = Samples[NextSample];
+    Sample.Offset = ((T1 - T0) + (T2 - T3)) * 0.5;
+    Sample.RoundTrip = RoundTrip;
+    NextSample = (NextSample + 1) % FilterSamples;
+
+    const FSample* Best = &Samples[0];
+    const int32 NumFiltered = FMath::Min(NumSamples + 1, FilterSamples);
+    for (int32 Index = 1; Index < NumFiltered; ++Index)
+    {
+        if (Samples[Index].RoundTrip < Best->RoundTrip)
+        {
+            Best = &Samples[Index];
+        }
+    }
+
+    if (NumSamples == 0)
+    {
+        Offset = Sample.Offset;
+        SmoothedRoundTrip = RoundTrip;
+    }
+    else
+    {
+        Offset += (Best->Offset - Offset) * OffsetSmoothing;
+        SmoothedRoundTrip += (RoundTrip - SmoothedRoundTrip) * RoundTripSmoothing;
+    }
+    NumSamples = FMath::Min(NumSamples + 1, FilterSamples);
+}
+
+void FFusionClockSync::Reset()
+{
+    NumSamples = 0;
+    NextSample = 0;
+    Offset = 0.0;
+    SmoothedRoundTrip = 0.0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * NTP-style estimate of the tracker clock against FPlatformTime::Seconds(), from ping/pong exchanges that carry four
+ * timestamps: T0 ping sent (local), T1 ping received and T2 pong sent (tracker), T3 pong received (local).
+ *
+ * Each exchange gives RTT = (T3 - T0) - (T2 - T1) and Offset = ((T1 - T0) + (T2 - T3)) / 2, exact when both legs take
+ * equally long. The offset is taken from the lowest-RTT exchange among the recent ones, where queueing distorted it
+ * least, and then smoothed; the reported RTT is smoothed over all exchanges. Game thread only.
+ */
+class FUSION_API FFusionClockSync
+{
+public:
+    /** Exchanges the offset filter picks from; at the default 5 s keep-alive this covers the last 40 s. */
+    static constexpr int32 FilterSamples = 8;
+
+    void AddSample(double T0, double T1, double T2, double T3);
+    void Reset();
+
+    bool HasEstimate() const { return NumSamples > 0; }
+    int32 GetSampleCount() const { return NumSamples; }
+
+    /** Tracker clock minus local clock in seconds. */
+    double GetOffset() const { return Offset; }
+
+    double GetRoundTrip() const { return SmoothedRoundTrip; }
+
+    /** Converts a tracker timestamp, such as a frame's capture time, to FPlatformTime::Seconds(). */
+    double ToLocalTime(double TrackerTime) const { return TrackerTime - Offset; }
+
+private:
+    struct FSample
+    {
+        double Offset = 0.0;
+        double RoundTrip = 0.0;
+    };
+
+    FSample Samples[FilterSamples];
+    int32 NumSamples = 0;
+    int32 NextSample = 0;
+
+    double Offset = 0.0;
+    double SmoothedRoundTrip = 0.0;
+};
@@ -0,0 +1,24 @@
+#include "FusionDebugOverlay.h"
+
+#include "Engine/Engine.h"
+
+bool FFusionDebugOverlay::ShouldUpdate(double Now, double& LastUpdate)
+{
+    if (Now - LastUpdate < UpdateSeconds)
+    {
+        return false;
+    }
+    LastUpdate = Now;
+    return true;
+}
+
+bool FFusionDebugOverlay::ShowLine(int32 Line, const FColor& Color, const FString& Message) const
+{
+    if (!GEngine || Line < 0 || Line >= MaxLines)
+    {
+        return false;
+    }
+
+    GEngine->AddOnScreenDebugMessage(KeyBase + Line, static_cast<float>(UpdateSeconds * 1.5), Color, Message);
+    return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A block of on-screen debug lines that replace each other in place on every refresh instead of scrolling. Each
+ * overlay passes its own tag so the blocks of different overlays never share message keys. Game thread only.
+ */
+class FUSION_API FFusionDebugOverlay
+{
+public:
+    /** Overlays refresh at most this often; their lines stay up a little longer so they do not flicker. */
+    static constexpr double UpdateSeconds = 0.5;
+
+    static constexpr int32 MaxLines = 8;
+
+    explicit constexpr FFusionDebugOverlay(uint32 Tag)
+        : KeyBase(static_cast<uint64>(Tag) << 16)
+    {
+    }
+
+    /** True once UpdateSeconds have passed since LastUpdate, which is then set to Now. */
+    static bool ShouldUpdate(double Now, double& LastUpdate);
+
+    /** Shows Message as line Line of this overlay; false when the line is past MaxLines or there is no engine. */
+    bool ShowLine(int32 Line, const FColor& Color, const FString& Message) const;
+
+private:
+    uint64 KeyBase;
+};
@@ -0,0 +1,190 @@
+#include "FusionGestureSequenceTracker.h"
+
+#include "FusionDebugOverlay.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+    TAutoConsoleVariable<bool> CVarStreamOverlay(
+        TEXT("Fusion.Gesture.StreamOverlay"),
+        false,
+        TEXT("Shows delivered and capture fps, loss, duplicates and reorders per gesture stream on screen."));
+
+    constexpr FFusionDebugOverlay StreamOverlay(0x46475351);
+}
+
+void FFusionGestureSequenceTracker::Record(int64 Sequence, double Now, double LatencySeconds)
+{
+    FBucket& Bucket = GetBucket(Now);
+    if (Received == 0)
+    {
+        FirstRecordTime = Now;
+    }
+    ++Received;
+    ++Bucket.Received;
+
+    if (LatencySeconds >= 0.0)
+    {
+        ++Bucket.LatencySamples;
+        Bucket.LatencySum += LatencySeconds;
+    }
+
+    if (Sequence == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (HighestSequence == INDEX_NONE || Sequence < HighestSequence - RestartDistance)
+    {
+        if (HighestSequence != INDEX_NONE)
+        {
+            ++Restarts;
+        }
+        FMemory::Memzero(SeenBits);
+        HighestSequence = Sequence;
+        StartSequence = Sequence;
+        SetSeen(Sequence, true);
+        return;
+    }
+
+    if (Sequence > HighestSequence)
+    {
+        const int64 Advance = Sequence - HighestSequence;
+        Lost += Advance - 1;
+        Bucket.Lost += static_cast<int32>(Advance - 1);
+        Bucket.Captured += Advance;
+
+        // Sequences entering the window replace ones that leave it.
+        if (Advance >= ReorderWindow)
+        {
+            FMemory::Memzero(SeenBits);
+        }
+        else
+        {
+            for (int64 Entering = HighestSequence + 1; Entering < Sequence; ++Entering)
+            {
+                SetSeen(Entering, false);
+            }
+        }
+        HighestSequence = Sequence;
+        SetSeen(Sequence, true);
+        return;
+    }
+
+    if (HighestSequence - Sequence < ReorderWindow && IsSeen(Sequence))
+    {
+        ++Duplicated;
+        ++Bucket.Duplicated;
+        return;
+    }
+
+    ++Reordered;
+    ++Bucket.Reordered;
+
+    // Only gaps after the starting sequence were counted as lost; earlier frames just arrived late.
+    if (HighestSequence - Sequence < ReorderWindow && Sequence > StartSequence)
+    {
+        SetSeen(Sequence, true);
+        --Lost;
+        ++Bucket.Recovered;
+    }
+}
+
+void FFusionGestureSequenceTracker::GetStats(double Now, FFusionGestureStreamStats& OutStats) const
+{
+    OutStats.FramesReceived = static_cast<int32>(Received);
+    OutStats.FramesLost = static_cast<int32>(Lost);
+    OutStats.FramesDuplicated = static_cast<int32>(Duplicated);
+    OutStats.FramesReordered = static_cast<int32>(Reordered);
+    OutStats.SequenceRestarts = Restarts;
+    OutStats.LastSequence = HighestSequence;
+
+    const int64 CurrentSecond = FMath::FloorToInt64(Now);
+    int64 WindowReceived = 0;
+    int64 WindowLost = 0;
+    int64 WindowCaptured = 0;
+    int64 WindowLatencySamples = 0;
+    double WindowLatencySum = 0.0;
+    for (const FBucket& Bucket : Buckets)
+    {
+        if (Bucket.Second != INDEX_NONE && CurrentSecond - Bucket.Second < RateWindowSeconds)
+        {
+            WindowReceived += Bucket.Received;
+            WindowLost += Bucket.Lost - Bucket.Recovered;
+            WindowCaptured += Bucket.Captured;
+            WindowLatencySamples += Bucket.LatencySamples;
+            WindowLatencySum += Bucket.LatencySum;
+        }
+    }
+
+    const double WindowStart = FMath::Max(FirstRecordTime, static_cast<double>(CurrentSecond - RateWindowSeconds + 1));
+    const double WindowSeconds = Now - WindowStart;
+    OutStats.DeliveredFps = WindowSeconds > 0.0 ? static_cast<float>(WindowReceived / WindowSeconds) : 0.f;
+    OutStats.CaptureFps = WindowSeconds > 0.0 ? static_cast<float>(WindowCaptured / WindowSeconds) : 0.f;
+    OutStats.WindowLossRatio = WindowCaptured > 0 ? FMath::Clamp(static_cast<float>(WindowLost) / WindowCaptured, 0.f, 1.f) : 0.f;
+    OutStats.LatencyMs = WindowLatencySamples > 0 ? static_cast<float>(WindowLatencySum / WindowLatencySamples * 1000.0) : -1.f;
+}
+
+bool FFusionGestureSequenceTracker::IsDebugOverlayEnabled()
+{
+    return CVarStreamOverlay.GetValueOnGameThread();
+}
+
+void FFusionGestureSequenceTracker::ShowDebugOverlay(const TArray<FFusionGestureStreamStats>& Streams, const FFusionGestureTransportStats& Transport)
+{
+    int32 Line = 0;
+    if (!Transport.Transport.IsEmpty())
+    {
+        const FString Message = FString::Printf(TEXT("%s transport %s  recv=%d delivered=%d lost=%d reordered=%d superseded=%d malformed=%d"),
+            *Transport.Transport, Transport.bConnected ? TEXT("up") : TEXT("down"), Transport.FramesReceived, Transport.FramesDelivered,
+            Transport.FramesLost, Transport.FramesReordered, Transport.FramesSuperseded, Transport.FramesMalformed);
+        StreamOverlay.ShowLine(Line, Transport.bConnected ? FColor::Cyan : FColor::Orange, Message);
+        ++Line;
+    }
+
+    for (const FFusionGestureStreamStats& Stream : Streams)
+    {
+        if (Line == FFusionDebugOverlay::MaxLines)
+        {
+            break;
+        }
+
+        const FString Message = FString::Printf(TEXT("%s  %.1f/%.1f fps  latency %.0fms  loss %.1f%%  lost=%d dup=%d reorder=%d restarts=%d seq=%lld"),
+            *Stream.Source, Stream.DeliveredFps, Stream.CaptureFps, Stream.LatencyMs, Stream.WindowLossRatio * 100.f,
+            Stream.FramesLost, Stream.FramesDuplicated, Stream.FramesReordered, Stream.SequenceRestarts, Stream.LastSequence);
+        const FColor Color = Stream.WindowLossRatio > 0.05f ? FColor::Orange : FColor::Cyan;
+        StreamOverlay.ShowLine(Line, Color, Message);
+        ++Line;
+    }
+}
+
+FFusionGestureSequenceTracker::FBucket& FFusionGestureSequenceTracker::GetBucket(double Now)
+{
+    const int64 Second = FMath::FloorToInt64(Now);
+    FBucket& Bucket = Buckets[Second % RateWindowSeconds];
+    if (Bucket.Second != Second)
+    {
+        Bucket = FBucket();
+        Bucket.Second = Second;
+    }
+    return Bucket;
+}
+
+bool FFusionGestureSequenceTracker::IsSeen(int64 Sequence) const
+{
+    const uint64 Slot = static_cast<uint64>(Sequence) % ReorderWindow;
+    return (SeenBits[Slot / 64] & (1ull << (Slot % 64))) != 0;
+}
+
+void FFusionGestureSequenceTracker::SetSeen(int64 Sequence, bool bSeen)
+{
+    const uint64 Slot = static_cast<uint64>(Sequence) % ReorderWindow;
+    if (bSeen)
+    {
+        SeenBits[Slot / 64] |= 1ull << (Slot % 64);
+    }
+    else
+    {
+        SeenBits[Slot / 64] &= ~(1ull << (Slot % 64));
+    }
+}
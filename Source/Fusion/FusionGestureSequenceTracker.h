@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FusionMode.h"
+
+/**
+ * Sequence accounting for one gesture stream: gaps, duplicates and reorders of the "seq" counter, plus delivered and
+ * capture rates over a rolling window. A frame arriving late fills the gap it left, so lost counts only frames that
+ * never came. Senders number the frames of each receiver's stream consecutively (see FFusionGestureFrame::Sequence),
+ * so rate throttling does not show up as loss. Fed with frames as AFusionMode processes them; game thread only.
+ *
+ * Console: Fusion.Gesture.StreamOverlay 0|1.
+ */
+class FUSION_API FFusionGestureSequenceTracker
+{
+public:
+    /** Late frames further back than this are counted as reordered without telling duplicates apart. */
+    static constexpr int32 ReorderWindow = 256;
+
+    /** Rates and window loss cover this many whole seconds, the current one included. */
+    static constexpr int32 RateWindowSeconds = 5;
+
+    /** A sequence this far behind the newest one seen means the sender restarted its counter. */
+    static constexpr int64 RestartDistance = 1000;
+
+    /**
+     * Records one delivered frame; frames without a sequence (INDEX_NONE) only count towards the delivered rate.
+     * LatencySeconds is the capture-to-now time on the local clock, negative when unknown.
+     */
+    void Record(int64 Sequence, double Now, double LatencySeconds = -1.0);
+
+    void GetStats(double Now, FFusionGestureStreamStats& OutStats) const;
+
+    static bool IsDebugOverlayEnabled();
+
+    /** Shows one line per stream on screen; call about twice a second while IsDebugOverlayEnabled. */
+    static void ShowDebugOverlay(const TArray<FFusionGestureStreamStats>& Streams, const FFusionGestureTransportStats& Transport);
+
+private:
+    struct FBucket
+    {
+        int64 Second = INDEX_NONE;
+        int32 Received = 0;
+        int32 Lost = 0;
+        int32 Recovered = 0;
+        int32 Duplicated = 0;
+        int32 Reordered = 0;
+
+        /** Advance of the highest sequence, i.e. frames the tracker captured. */
+        int64 Captured = 0;
+
+        int32 LatencySamples = 0;
+        double LatencySum = 0.0;
+    };
+
+    FBucket& GetBucket(double Now);
+    bool IsSeen(int64 Sequence) const;
+    void SetSeen(int64 Sequence, bool bSeen);
+
+    FBucket Buckets[RateWindowSeconds];
+    uint64 SeenBits[ReorderWindow / 64] = {};
+    int64 HighestSequence = INDEX_NONE;
+
+    /** First sequence since the last (re)start; nothing before it was ever counted lost. */
+    int64 StartSequence = INDEX_NONE;
+    double FirstRecordTime = 0.0;
+
+    int64 Received = 0;
+    int64 Lost = 0;
+    int64 Duplicated = 0;
+    int64 Reordered = 0;
+    int32 Restarts = 0;
+};
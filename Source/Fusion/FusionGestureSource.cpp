@@ -0,0 +1,169 @@
+#include "FusionGestureSource.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+namespace FusionGestureJson
+{
+    void ParseHands(const FJsonObject& Payload, TArray<FFusionHandSnapshot>& OutHands)
+    {
+        OutHands.Reset();
+
+        TArray<const FJsonObject*> HandObjects;
+
+        const TArray<TSharedPtr<FJsonValue>>* HandsArray = nullptr;
+        if (Payload.TryGetArrayField(TEXT("hands"), HandsArray) && HandsArray)
+        {
+            for (const TSharedPtr<FJsonValue>& HandValue : *HandsArray)
+            {
+                const TSharedPtr<FJsonObject>* HandObject = nullptr;
+                if (HandValue.IsValid() && HandValue->TryGetObject(HandObject) && HandObject && HandObject->IsValid())
+                {
+                    HandObjects.Add(HandObject->Get());
+                }
+            }
+        }
+        else
+        {
+            const TSharedPtr<FJsonObject>* NestedHand = nullptr;
+            if (Payload.TryGetObjectField(TEXT("hand"), NestedHand) && NestedHand && NestedHand->IsValid())
+            {
+                HandObjects.Add(NestedHand->Get());
+            }
+            else if (Payload.HasField(TEXT("x_y_z")) || Payload.HasField(TEXT("state")))
+            {
+                HandObjects.Add(&Payload);
+            }
+        }
+
+        if (HandObjects.Num() == 0)
+        {
+            return;
+        }
+
+        OutHands.Reserve(HandObjects.Num());
+
+        // Landmark ids of sparse frames, listed per hand or once for the whole frame.
+        const TArray<TSharedPtr<FJsonValue>>* FrameLandmarkIds = nullptr;
+        Payload.TryGetArrayField(TEXT("landmarks"), FrameLandmarkIds);
+
+        for (const FJsonObject* HandObject : HandObjects)
+        {
+            FFusionHandSnapshot HandSnapshot;
+
+            const TArray<TSharedPtr<FJsonValue>>* LandmarkIds = FrameLandmarkIds;
+            HandObject->TryGetArrayField(TEXT("landmarks"), LandmarkIds);
+            if (LandmarkIds)
+            {
+                uint32 Mask = 0;
+                for (const TSharedPtr<FJsonValue>& IdValue : *LandmarkIds)
+                {
+                    int32 LandmarkId = INDEX_NONE;
+                    if (IdValue.IsValid() && IdValue->TryGetNumber(LandmarkId) && LandmarkId >= 0 && LandmarkId < 32)
+                    {
+                        Mask |= 1u << LandmarkId;
+                    }
+                }
+                HandSnapshot.LandmarkMask = static_cast<int32>(Mask);
+            }
+
+            FString ParsedState;
+            if (HandObject->TryGetStringField(TEXT("state"), ParsedState)
+                || HandObject->TryGetStringField(TEXT("hand_state"), ParsedState)
+                || HandObject->TryGetStringField(TEXT("gesture"), ParsedState))
+            {
+                HandSnapshot.state = ParsedState;
+            }
+
+            // Not "hand" on the frame itself, where that is the nested hand object or the frame's own handedness.
+            HandObject->TryGetStringField(TEXT("handedness"), HandSnapshot.Handedness);
+            if (HandSnapshot.Handedness.IsEmpty() && HandObject != &Payload)
+            {
+                HandObject->TryGetStringField(TEXT("hand"), HandSnapshot.Handedness);
+            }
+
+            const TArray<TSharedPtr<FJsonValue>>* CoordinatesArray = nullptr;
+            if (HandObject->TryGetArrayField(TEXT("x_y_z"), CoordinatesArray) && CoordinatesArray)
+            {
+                HandSnapshot.x_y_z.Reserve(CoordinatesArray->Num());
+                for (const TSharedPtr<FJsonValue>& CoordinateValue : *CoordinatesArray)
+                {
+                    if (!CoordinateValue.IsValid())
+                    {
+                        continue;
+                    }
+
+                    double CoordinateNumber = 0.0;
+                    if (CoordinateValue->TryGetNumber(CoordinateNumber))
+                    {
+                        HandSnapshot.x_y_z.Add(static_cast<float>(CoordinateNumber));
+                        continue;
+                    }
+
+                    const TArray<TSharedPtr<FJsonValue>>* NestedArray = nullptr;
+                    if (CoordinateValue->TryGetArray(NestedArray) && NestedArray)
+                    {
+                        for (const TSharedPtr<FJsonValue>& NestedValue : *NestedArray)
+                        {
+                            double NestedNumber = 0.0;
+                            if (NestedValue.IsValid() && NestedValue->TryGetNumber(NestedNumber))
+                            {
+                                HandSnapshot.x_y_z.Add(static_cast<float>(NestedNumber));
+                            }
+                        }
+                    }
+                }
+            }
+
+            OutHands.Add(MoveTemp(HandSnapshot));
+        }
+    }
+
+    void ParseFrame(const FJsonObject& Payload, FFusionGestureFrame& OutFrame)
+    {
+        ParseHands(Payload, OutFrame.Hands);
+
+        Payload.TryGetStringField(TEXT("gesture"), OutFrame.Gesture);
+        if (OutFrame.Gesture.IsEmpty())
+        {
+            Payload.TryGetStringField(TEXT("hand_state"), OutFrame.Gesture);
+        }
+
+        // "hand" may also be the nested hand object, which TryGetStringField skips.
+        Payload.TryGetStringField(TEXT("hand"), OutFrame.Hand);
+        if (OutFrame.Hand.IsEmpty())
+        {
+            Payload.TryGetStringField(TEXT("handedness"), OutFrame.Hand);
+        }
+
+        Payload.TryGetStringField(TEXT("object_id"), OutFrame.ObjectHint);
+        if (OutFrame.ObjectHint.IsEmpty())
+        {
+            Payload.TryGetStringField(TEXT("object_hint"), OutFrame.ObjectHint);
+        }
+
+        Payload.TryGetStringField(TEXT("source"), OutFrame.Source);
+        Payload.TryGetNumberField(TEXT("seq"), OutFrame.Sequence);
+        Payload.TryGetNumberField(TEXT("timestamp"), OutFrame.CaptureTimestamp);
+    }
+
+    void ParseFrames(const FJsonObject& Payload, TArray<FFusionGestureFrame>& OutFrames)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Frames = nullptr;
+        if (!Payload.TryGetArrayField(TEXT("frames"), Frames) || !Frames)
+        {
+            ParseFrame(Payload, OutFrames.AddDefaulted_GetRef());
+            return;
+        }
+
+        OutFrames.Reserve(OutFrames.Num() + Frames->Num());
+        for (const TSharedPtr<FJsonValue>& FrameValue : *Frames)
+        {
+            const TSharedPtr<FJsonObject>* FrameObject = nullptr;
+            if (FrameValue.IsValid() && FrameValue->TryGetObject(FrameObject) && FrameObject && FrameObject->IsValid())
+            {
+                ParseFrame(**FrameObject, OutFrames.AddDefaulted_GetRef());
+            }
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FusionMode.h"
+
+/** One tracker frame, independent of the transport it arrived over. */
+struct FFusionGestureFrame
+{
+    TArray<FFusionHandSnapshot> Hands;
+
+    /** Frame-level gesture label ("point", "fist", ...), falling back to hand_state. */
+    FString Gesture;
+
+    /** Frame-level hand/handedness field; some trackers report "fist" here. */
+    FString Hand;
+
+    /** Object the tracker believes is being pointed at. */
+    FString ObjectHint;
+
+    /** Stream the frame belongs to when one tracker process serves several cameras; empty otherwise. */
+    FString Source;
+
+    /**
+     * Sender frame counter, if the transport carries one. Senders count the frames they send to this receiver, so
+     * frames skipped to honour a negotiated rate ("fps") leave no gap; a gap always means a lost frame.
+     */
+    int64 Sequence = INDEX_NONE;
+
+    /** Tracker clock in seconds when the camera frame was captured; 0 if unknown. */
+    double CaptureTimestamp = 0.0;
+};
+
+/** JSON frame format shared by the gesture WebSocket and the UDP transport. */
+namespace FusionGestureJson
+{
+    /**
+     * Reads a "hands" array, a single "hand" object, or hand fields at the top level. A "landmarks" id array, per hand
+     * or for the whole frame, marks x_y_z as sparse: it then holds those landmarks only, in ascending id order.
+     */
+    FUSION_API void ParseHands(const FJsonObject& Payload, TArray<FFusionHandSnapshot>& OutHands);
+
+    /** Reads hands plus the frame-level gesture, hand, object hint, "seq" and "timestamp" fields. */
+    FUSION_API void ParseFrame(const FJsonObject& Payload, FFusionGestureFrame& OutFrame);
+
+    /**
+     * Appends the frames of a message: every entry of a {"type":"frames","frames":[..]} batch, oldest first, or the
+     * message itself when it is a single frame.
+     */
+    FUSION_API void ParseFrames(const FJsonObject& Payload, TArray<FFusionGestureFrame>& OutFrames);
+}
+
+/**
+ * A transport delivering gesture frames besides the gesture WebSocket. AFusionMode polls the active source every
+ * tick and runs each frame through the same pipeline as WebSocket messages. Game thread only.
+ */
+class FUSION_API IFusionGestureSource
+{
+public:
+    virtual ~IFusionGestureSource() = default;
+
+    /** Appends the frames that arrived since the previous call, oldest first. */
+    virtual void Poll(TArray<FFusionGestureFrame>& OutFrames) = 0;
+
+    virtual bool IsConnected() const = 0;
+
+    virtual const TCHAR* GetName() const = 0;
+
+    virtual FFusionGestureTransportStats GetStats() const = 0;
+};
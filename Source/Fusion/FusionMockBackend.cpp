@@ -0,0 +1,1327 @@
+#include "FusionMockBackend.h"
+
+#if WITH_FUSION_MOCK_BACKEND
+
+#include "FusionSharedMemoryGestureSource.h"
+#include "FusionSocketChannel.h"
+
+#include <atomic>
+
+#include "Common/UdpSocketBuilder.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Thread.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "INetworkingWebSocket.h"
+#include "IHttpRouter.h"
+#include "IWebSocketNetworkingModule.h"
+#include "IWebSocketServer.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+#include "WebSocketNetworkingDelegates.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFusionMock, Log, All);
+
+bool FFusionMockLatency::Parse(const FString& Spec)
+{
+    TArray<FString> Parts;
+    Spec.ParseIntoArray(Parts, TEXT(":"));
+    if (Parts.Num() == 0)
+    {
+        return false;
+    }
+
+    // A bare number is a constant delay.
+    if (Parts[0].IsNumeric())
+    {
+        Distribution = EDistribution::Constant;
+        MeanSeconds = FCString::Atof(*Parts[0]);
+        Spread = 0.f;
+        return true;
+    }
+
+    if (Parts[0].Equals(TEXT("constant"), ESearchCase::IgnoreCase))
+    {
+        Distribution = EDistribution::Constant;
+    }
+    else if (Parts[0].Equals(TEXT("uniform"), ESearchCase::IgnoreCase))
+    {
+        Distribution = EDistribution::Uniform;
+    }
+    else if (Parts[0].Equals(TEXT("lognormal"), ESearchCase::IgnoreCase))
+    {
+        Distribution = EDistribution::LogNormal;
+    }
+    else
+    {
+        return false;
+    }
+
+    MeanSeconds = Parts.IsValidIndex(1) ? FCString::Atof(*Parts[1]) : 0.f;
+    Spread = Parts.IsValidIndex(2) ? FCString::Atof(*Parts[2]) : 0.f;
+    return true;
+}
+
+float FFusionMockLatency::Sample(FRandomStream& Random) const
+{
+    switch (Distribution)
+    {
+    case EDistribution::Uniform:
+        return FMath::Max(0.f, MeanSeconds + Random.FRandRange(-Spread, Spread));
+
+    case EDistribution::LogNormal:
+    {
+        // Box-Muller; scaled so the distribution mean stays at MeanSeconds while Spread stretches the tail.
+        const float U1 = FMath::Max(Random.FRand(), UE_SMALL_NUMBER);
+        const float U2 = Random.FRand();
+        const float Normal = FMath::Sqrt(-2.f * FMath::Loge(U1)) * FMath::Cos(2.f * UE_PI * U2);
+        return MeanSeconds * FMath::Exp(Spread * Normal - 0.5f * Spread * Spread);
+    }
+
+    default:
+        return FMath::Max(0.f, MeanSeconds);
+    }
+}
+
+void FFusionMockBackendSettings::ApplyArgs(const TArray<FString>& Args)
+{
+    TArray<FString> Tokens;
+
+    for (const FString& Arg : Args)
+    {
+        FString ScenarioPath;
+        if (!FParse::Value(*Arg, TEXT("Scenario="), ScenarioPath))
+        {
+            continue;
+        }
+
+        // Scenario files use the same keys as the console arguments: {"Fps": 240, "Script": ["point@colobus:1", "fist:0.5"]}
+        FString ScenarioText;
+        TSharedPtr<FJsonObject> Scenario;
+        if (!FFileHelper::LoadFileToString(ScenarioText, *ScenarioPath) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ScenarioText), Scenario) || !Scenario.IsValid())
+        {
+            UE_LOG(LogFusionMock, Warning, TEXT("Could not read mock scenario %s"), *ScenarioPath);
+            continue;
+        }
+
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Scenario->Values)
+        {
+            FString Value;
+            const TArray<TSharedPtr<FJsonValue>>* Items = nullptr;
+            if (Field.Value->TryGetArray(Items) && Items)
+            {
+                TArray<FString> Parts;
+                for (const TSharedPtr<FJsonValue>& Item : *Items)
+                {
+                    Parts.Add(Item->AsString());
+                }
+                Value = FString::Join(Parts, TEXT(","));
+            }
+            else
+            {
+                Value = Field.Value->AsString();
+            }
+            Tokens.Add(FString::Printf(TEXT("%s=%s"), *Field.Key, *Value));
+        }
+    }
+
+    Tokens.Append(Args);
+
+    for (const FString& Token : Tokens)
+    {
+        FParse::Value(*Token, TEXT("GesturePort="), GesturePort);
+        FParse::Value(*Token, TEXT("RestPort="), RestPort);
+        FParse::Value(*Token, TEXT("Seed="), Seed);
+        FParse::Value(*Token, TEXT("Fps="), GestureFps);
+        FParse::Value(*Token, TEXT("FramesPerMessage="), FramesPerMessage);
+        FParse::Value(*Token, TEXT("Hands="), HandsPerFrame);
+        FParse::Value(*Token, TEXT("Landmarks="), LandmarksPerHand);
+        FParse::Value(*Token, TEXT("DisconnectEvery="), DisconnectIntervalSeconds);
+        FParse::Value(*Token, TEXT("GestureMalformedRate="), GestureMalformedRate);
+        FParse::Value(*Token, TEXT("SharedMemory="), SharedMemoryName);
+        FParse::Value(*Token, TEXT("UdpTarget="), UdpTarget);
+        FParse::Value(*Token, TEXT("UdpLossRate="), UdpLossRate);
+        FParse::Value(*Token, TEXT("UdpReorderRate="), UdpReorderRate);
+        FParse::Value(*Token, TEXT("DescErrorRate="), DescriptionFailures.ErrorRate);
+        FParse::Value(*Token, TEXT("DescHangRate="), DescriptionFailures.HangRate);
+        FParse::Value(*Token, TEXT("DescMalformedRate="), DescriptionFailures.MalformedRate);
+        FParse::Value(*Token, TEXT("VoiceErrorRate="), VoiceFailures.ErrorRate);
+        FParse::Value(*Token, TEXT("VoiceHangRate="), VoiceFailures.HangRate);
+        FParse::Value(*Token, TEXT("VoiceMalformedRate="), VoiceFailures.MalformedRate);
+        FParse::Value(*Token, TEXT("VoiceTokens="), VoiceTokenCount);
+        FParse::Bool(*Token, TEXT("Batch="), bSupportBatch);
+        FParse::Bool(*Token, TEXT("SocketRequests="), bSupportSocketRequests);
+
+        FString Text;
+        if (FParse::Value(*Token, TEXT("Shape="), Text))
+        {
+            PayloadShape = Text.Equals(TEXT("single"), ESearchCase::IgnoreCase) ? EPayloadShape::SingleHand
+                : Text.Equals(TEXT("nested"), ESearchCase::IgnoreCase) ? EPayloadShape::NestedCoordinates
+                : EPayloadShape::Hands;
+        }
+        if (FParse::Value(*Token, TEXT("Script="), Text, false))
+        {
+            Text.ParseIntoArray(GestureScript, TEXT(","));
+        }
+        if (FParse::Value(*Token, TEXT("DescLatency="), Text) && !DescriptionLatency.Parse(Text))
+        {
+            UE_LOG(LogFusionMock, Warning, TEXT("Unrecognised latency spec '%s'"), *Text);
+        }
+        if (FParse::Value(*Token, TEXT("VoiceLatency="), Text) && !VoiceLatency.Parse(Text))
+        {
+            UE_LOG(LogFusionMock, Warning, TEXT("Unrecognised latency spec '%s'"), *Text);
+        }
+    }
+
+    GestureFps = FMath::Max(0.f, GestureFps);
+    FramesPerMessage = FMath::Clamp(FramesPerMessage, 1, 64);
+    HandsPerFrame = FMath::Clamp(HandsPerFrame, 0, 4);
+    LandmarksPerHand = FMath::Clamp(LandmarksPerHand, 1, 64);
+}
+
+FString FFusionMockBackendSettings::ToString() const
+{
+    static const TCHAR* ShapeNames[] = { TEXT("hands"), TEXT("single"), TEXT("nested") };
+    return FString::Printf(TEXT("ws:%d rest:%d shm:%s udp:%s(loss %.2f reorder %.2f) fps=%.1f frames/msg=%d hands=%d landmarks=%d shape=%s script=[%s] desc=%.2fs(err %.2f hang %.2f bad %.2f) voice=%.2fs(err %.2f hang %.2f bad %.2f) batch=%s socket-requests=%s"),
+        GesturePort, RestPort, SharedMemoryName.IsEmpty() ? TEXT("off") : *SharedMemoryName,
+        UdpTarget.IsEmpty() ? TEXT("off") : *UdpTarget, UdpLossRate, UdpReorderRate, GestureFps, FramesPerMessage, HandsPerFrame, LandmarksPerHand, ShapeNames[static_cast<int32>(PayloadShape)], *FString::Join(GestureScript, TEXT(",")),
+        DescriptionLatency.MeanSeconds, DescriptionFailures.ErrorRate, DescriptionFailures.HangRate, DescriptionFailures.MalformedRate,
+        VoiceLatency.MeanSeconds, VoiceFailures.ErrorRate, VoiceFailures.HangRate, VoiceFailures.MalformedRate,
+        bSupportBatch ? TEXT("on") : TEXT("off"), bSupportSocketRequests ? TEXT("on") : TEXT("off"));
+}
+
+namespace FusionMockBackend
+{
+    /** Hung requests are answered with an error after this long, well past any client deadline. */
+    static constexpr float HangSeconds = 120.f;
+
+    struct FScriptStep
+    {
+        FString Gesture;
+        FString ObjectId;
+        double Seconds = 1.0;
+    };
+
+    static TArray<FScriptStep> ParseScript(const TArray<FString>& Script)
+    {
+        TArray<FScriptStep> Steps;
+        for (const FString& Entry : Script)
+        {
+            FString Head = Entry.TrimStartAndEnd();
+            FString SecondsText;
+            FScriptStep& Step = Steps.AddDefaulted_GetRef();
+            if (Head.Split(TEXT(":"), &Head, &SecondsText, ESearchCase::CaseSensitive, ESearchDir::FromEnd))
+            {
+                Step.Seconds = FMath::Max(0.01, FCString::Atod(*SecondsText));
+            }
+            if (!Head.Split(TEXT("@"), &Step.Gesture, &Step.ObjectId))
+            {
+                Step.Gesture = Head;
+            }
+        }
+
+        if (Steps.Num() == 0)
+        {
+            Steps.Add({ TEXT("open"), FString(), 1.0 });
+        }
+        return Steps;
+    }
+
+    /** Body fields of a description answer, shared by the REST and socket endpoints. */
+    static FString MakeDescriptionJson(const FString& ObjectId)
+    {
+        return FString::Printf(TEXT("{\"object_id\":\"%s\",\"description\":\"Mock description of %s.\",\"tts_url\":\"/tts/%s.wav\"}"), *ObjectId, *ObjectId, *ObjectId);
+    }
+
+    static FString MakeVoiceQuestion(int64 QueryNumber, int32 AudioBytes)
+    {
+        return FString::Printf(TEXT("Mock question #%lld (%d bytes of audio)"), QueryNumber, AudioBytes);
+    }
+
+    static TArray<FString> MakeVoiceTokens(int32 Count)
+    {
+        static const TCHAR* Words[] = { TEXT("This"), TEXT("is"), TEXT("a"), TEXT("mock"), TEXT("answer"), TEXT("from"), TEXT("the"), TEXT("in-process"), TEXT("backend") };
+
+        TArray<FString> Tokens;
+        for (int32 Index = 0; Index < FMath::Max(1, Count); ++Index)
+        {
+            Tokens.Add(FString(Index > 0 ? TEXT(" ") : TEXT("")) + Words[Index % UE_ARRAY_COUNT(Words)]);
+        }
+        return Tokens;
+    }
+
+    /** Prefixes a JSON object's fields with a message type and request id: {"type":..,"request_id":..,<fields>}. */
+    static FString MakeSocketReply(const TCHAR* Type, int64 RequestId, const FString& FieldsJson = TEXT("{}"))
+    {
+        const FString Fields = FieldsJson.Mid(1, FieldsJson.Len() - 2);
+        return FString::Printf(TEXT("{\"type\":\"%s\",\"request_id\":%lld%s%s}"), Type, RequestId, Fields.IsEmpty() ? TEXT("") : TEXT(","), *Fields);
+    }
+
+    class FGestureServer
+    {
+    public:
+        ~FGestureServer()
+        {
+            Stop();
+        }
+
+        bool Start(const FFusionMockBackendSettings& InSettings)
+        {
+            UpdateSettings(InSettings);
+            Port = InSettings.GesturePort;
+            if (!CreateServer())
+            {
+                return false;
+            }
+
+            bStopping = false;
+            Thread = MakeUnique<FThread>(TEXT("FusionMockGesture"), [this]() { Run(); }, 0, TPri_AboveNormal);
+            return true;
+        }
+
+        void Stop()
+        {
+            bStopping = true;
+            if (Thread.IsValid())
+            {
+                Thread->Join();
+                Thread.Reset();
+            }
+            DestroyServer();
+            ShmWriter.Close();
+            ShmWriterName.Reset();
+            CloseUdp();
+        }
+
+        void UpdateSettings(const FFusionMockBackendSettings& InSettings)
+        {
+            FScopeLock ScopeLock(&SettingsLock);
+            PendingSettings = InSettings;
+            ++SettingsVersion;
+        }
+
+        void LogStats() const
+        {
+            UE_LOG(LogFusionMock, Display, TEXT("Gesture: clients=%d frames=%lld behind-schedule=%lld malformed=%lld drops=%lld socket-requests=%lld rate-changes=%lld udp-dropped=%lld udp-reordered=%lld"),
+                ConnectedClients.load(), FramesSent.load(), FramesBehind.load(), FramesMalformed.load(), Disconnects.load(), SocketRequests.load(), RateChanges.load(),
+                DatagramsDropped.load(), DatagramsReordered.load());
+        }
+
+    private:
+        struct FClient
+        {
+            TUniquePtr<INetworkingWebSocket> Socket;
+            bool bClosed = false;
+
+            /** Rate the client asked for with "subscribe" or "fps" (0 = every frame), and when it is due its next one. */
+            double RequestedFps = 0.0;
+            double NextFrameTime = 0.0;
+
+            /** Landmarks the client subscribed to, bit per id; 0 = all. */
+            uint32 LandmarkMask = 0;
+
+            /** "seq" of the client's next frame; counts only frames this client is sent, so throttling leaves no gaps. */
+            int64 NextSequence = 0;
+
+            /** Open "frames" batch while FramesPerMessage > 1, as UTF-8 up to and including the last frame. */
+            TArray<uint8> PendingBatch;
+            int32 PendingBatchFrames = 0;
+        };
+
+        /** Socket request answers waiting out their sampled latency. */
+        struct FDelayedReply
+        {
+            double SendTime = 0.0;
+            TWeakPtr<FClient> Client;
+            int64 RequestId = 0;
+            FString Text;
+        };
+
+        bool CreateServer()
+        {
+            Server = FModuleManager::LoadModuleChecked<IWebSocketNetworkingModule>(TEXT("WebSocketNetworking")).CreateServer();
+
+            FWebSocketClientConnectedCallBack OnConnected;
+            OnConnected.BindRaw(this, &FGestureServer::HandleClientConnected);
+            if (!Server.IsValid() || !Server->Init(Port, OnConnected))
+            {
+                UE_LOG(LogFusionMock, Error, TEXT("Mock gesture server could not listen on port %d"), Port);
+                Server.Reset();
+                return false;
+            }
+            return true;
+        }
+
+        void DestroyServer()
+        {
+            Clients.Reset();
+            ConnectedClients = 0;
+            Server.Reset();
+        }
+
+        void HandleClientConnected(INetworkingWebSocket* Socket)
+        {
+            const TSharedRef<FClient> Client = MakeShared<FClient>();
+            Client->Socket.Reset(Socket);
+
+            TWeakPtr<FClient> WeakClient = Client;
+            FWebSocketInfoCallBack OnClosed;
+            OnClosed.BindLambda([WeakClient]()
+            {
+                if (const TSharedPtr<FClient> Closed = WeakClient.Pin())
+                {
+                    Closed->bClosed = true;
+                }
+            });
+            Socket->SetSocketClosedCallBack(OnClosed);
+
+            // Runs inside Server->Tick() on the server thread, like everything else that touches Settings and Random.
+            FWebSocketPacketReceivedCallBack OnReceived;
+            OnReceived.BindLambda([this, WeakClient](void* Data, int32 Size)
+            {
+                const TSharedPtr<FClient> Sender = WeakClient.Pin();
+                if (Sender.IsValid() && Size > 0)
+                {
+                    HandleClientMessage(Sender.ToSharedRef(), static_cast<const uint8*>(Data), Size);
+                }
+            });
+            Socket->SetReceiveCallBack(OnReceived);
+
+            Clients.Add(Client);
+            ConnectedClients = Clients.Num();
+        }
+
+        void HandleClientMessage(const TSharedRef<FClient>& Sender, const uint8* Data, int32 Size)
+        {
+            FString Text;
+            TConstArrayView<uint8> Payload;
+            if (!FFusionSocketChannel::DecodeBinaryFrame(MakeArrayView(Data, Size), Text, Payload))
+            {
+                const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Size);
+                Text = FString(Converted.Length(), Converted.Get());
+            }
+
+            TSharedPtr<FJsonObject> Message;
+            FString Type;
+            if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Message) || !Message.IsValid() || !Message->TryGetStringField(TEXT("type"), Type))
+            {
+                return;
+            }
+
+            if (Type == TEXT("ping"))
+            {
+                // Answers on the clock frame timestamps use, so the client can map one onto its own.
+                const double ReceiveTime = FPlatformTime::Seconds() - ClockOrigin;
+                double SendTime = 0.0;
+                if (!Message->TryGetNumberField(TEXT("t0"), SendTime))
+                {
+                    SendText(*Sender, TEXT("{\"type\":\"pong\"}"));
+                    return;
+                }
+                SendText(*Sender, FString::Printf(TEXT("{\"type\":\"pong\",\"t0\":%.6f,\"t1\":%.6f,\"t2\":%.6f}"),
+                    SendTime, ReceiveTime, FPlatformTime::Seconds() - ClockOrigin));
+                return;
+            }
+
+            // Field selection in "subscribe" is accepted but not applied; every frame carries all fields.
+            if (Type == TEXT("subscribe") || Type == TEXT("fps"))
+            {
+                double Fps = 0.0;
+                Message->TryGetNumberField(TEXT("fps"), Fps);
+                Sender->RequestedFps = FMath::Max(0.0, Fps);
+                ++RateChanges;
+
+                if (Type == TEXT("subscribe"))
+                {
+                    Sender->LandmarkMask = 0;
+                    const TArray<TSharedPtr<FJsonValue>>* Landmarks = nullptr;
+                    if (Message->TryGetArrayField(TEXT("landmarks"), Landmarks) && Landmarks)
+                    {
+                        for (const TSharedPtr<FJsonValue>& Landmark : *Landmarks)
+                        {
+                            int32 Id = INDEX_NONE;
+                            if (Landmark.IsValid() && Landmark->TryGetNumber(Id) && Id >= 0 && Id < 32)
+                            {
+                                Sender->LandmarkMask |= 1u << Id;
+                            }
+                        }
+                    }
+                }
+                return;
+            }
+
+            int64 RequestId = 0;
+            if (!Message->TryGetNumberField(TEXT("request_id"), RequestId))
+            {
+                return;
+            }
+
+            if (Type == TEXT("cancel"))
+            {
+                DelayedReplies.RemoveAll([&Sender, RequestId](const FDelayedReply& Reply)
+                {
+                    return Reply.RequestId == RequestId && Reply.Client.HasSameObject(&Sender.Get());
+                });
+                return;
+            }
+
+            ++SocketRequests;
+            if (!Settings.bSupportSocketRequests)
+            {
+                SendText(*Sender, MakeSocketReply(TEXT("error"), RequestId, TEXT("{\"code\":\"unsupported\",\"message\":\"Socket requests are disabled\"}")));
+                return;
+            }
+
+            TArray<FString> Replies;
+            if (Type == TEXT("describe"))
+            {
+                FString ObjectId;
+                Message->TryGetStringField(TEXT("object_id"), ObjectId);
+                Replies.Add(MakeSocketReply(TEXT("description"), RequestId, MakeDescriptionJson(ObjectId)));
+                QueueReplies(Sender, RequestId, Settings.DescriptionLatency, Settings.DescriptionFailures, MoveTemp(Replies));
+            }
+            else if (Type == TEXT("voice_query"))
+            {
+                const FString Question = MakeVoiceQuestion(SocketRequests.load(), Payload.Num());
+                const TArray<FString> Tokens = MakeVoiceTokens(Settings.VoiceTokenCount);
+
+                bool bStream = false;
+                Message->TryGetBoolField(TEXT("stream"), bStream);
+                if (bStream)
+                {
+                    Replies.Add(MakeSocketReply(TEXT("voice_question"), RequestId, FString::Printf(TEXT("{\"user_question\":\"%s\"}"), *Question)));
+                    for (const FString& Token : Tokens)
+                    {
+                        Replies.Add(MakeSocketReply(TEXT("voice_token"), RequestId, FString::Printf(TEXT("{\"token\":\"%s\"}"), *Token)));
+                    }
+                }
+                Replies.Add(MakeSocketReply(TEXT("voice_answer"), RequestId,
+                    FString::Printf(TEXT("{\"user_question\":\"%s\",\"llm_result\":\"%s\"}"), *Question, *FString::Join(Tokens, TEXT("")))));
+                QueueReplies(Sender, RequestId, Settings.VoiceLatency, Settings.VoiceFailures, MoveTemp(Replies));
+            }
+            else
+            {
+                SendText(*Sender, MakeSocketReply(TEXT("error"), RequestId, TEXT("{\"code\":\"unsupported\",\"message\":\"Unknown request type\"}")));
+            }
+        }
+
+        void QueueReplies(const TSharedRef<FClient>& Client, int64 RequestId, const FFusionMockLatency& Latency, const FFusionMockFailures& Failures, TArray<FString>&& Replies)
+        {
+            // Same failure draw as the REST endpoints; a hang simply never answers.
+            const float Roll = Random.FRand();
+            if (Roll < Failures.ErrorRate)
+            {
+                Replies = { MakeSocketReply(TEXT("error"), RequestId, TEXT("{\"code\":\"mock_failure\",\"message\":\"Injected by the Fusion mock backend\"}")) };
+            }
+            else if (Roll < Failures.ErrorRate + Failures.HangRate)
+            {
+                return;
+            }
+            else if (Roll < Failures.ErrorRate + Failures.HangRate + Failures.MalformedRate)
+            {
+                Replies.Last().LeftInline(Replies.Last().Len() / 2);
+            }
+
+            // Streamed pieces trickle out after the first one so the client sees tokens arrive over time.
+            constexpr double TokenIntervalSeconds = 0.03;
+            const double FirstReplyTime = FPlatformTime::Seconds() + Latency.Sample(Random);
+            for (int32 Index = 0; Index < Replies.Num(); ++Index)
+            {
+                FDelayedReply& Reply = DelayedReplies.AddDefaulted_GetRef();
+                Reply.SendTime = FirstReplyTime + Index * TokenIntervalSeconds;
+                Reply.Client = Client;
+                Reply.RequestId = RequestId;
+                Reply.Text = MoveTemp(Replies[Index]);
+            }
+        }
+
+        void SendDueReplies(double Now)
+        {
+            for (int32 Index = 0; Index < DelayedReplies.Num();)
+            {
+                if (DelayedReplies[Index].SendTime > Now)
+                {
+                    ++Index;
+                    continue;
+                }
+
+                const TSharedPtr<FClient> Client = DelayedReplies[Index].Client.Pin();
+                if (Client.IsValid() && !Client->bClosed)
+                {
+                    SendText(*Client, DelayedReplies[Index].Text);
+                }
+                DelayedReplies.RemoveAt(Index);
+            }
+        }
+
+        static void SendText(FClient& Client, const FString& Text)
+        {
+            const FTCHARToUTF8 Utf8(*Text, Text.Len());
+            Client.Socket->Send(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length(), false);
+        }
+
+        void Run()
+        {
+            ClockOrigin = FPlatformTime::Seconds();
+            double NextFrameTime = ClockOrigin;
+            double LastDisconnectTime = ClockOrigin;
+            int32 AppliedVersion = -1;
+
+            while (!bStopping)
+            {
+                if (Server.IsValid())
+                {
+                    Server->Tick();
+                }
+
+                {
+                    FScopeLock ScopeLock(&SettingsLock);
+                    if (AppliedVersion != SettingsVersion)
+                    {
+                        AppliedVersion = SettingsVersion;
+                        Settings = PendingSettings;
+                        Script = ParseScript(Settings.GestureScript);
+                        Random.Initialize(Settings.Seed);
+                    }
+                }
+
+                if (Settings.SharedMemoryName != ShmWriterName)
+                {
+                    ShmWriterName = Settings.SharedMemoryName;
+                    ShmWriter.Close();
+                    if (!ShmWriterName.IsEmpty())
+                    {
+                        ShmWriter.Open(ShmWriterName);
+                    }
+                }
+
+                if (Settings.UdpTarget != UdpTargetName)
+                {
+                    UdpTargetName = Settings.UdpTarget;
+                    CloseUdp();
+                    if (!UdpTargetName.IsEmpty())
+                    {
+                        OpenUdp(UdpTargetName);
+                    }
+                }
+
+                Clients.RemoveAll([](const TSharedRef<FClient>& Client) { return Client->bClosed; });
+                ConnectedClients = Clients.Num();
+
+                const double Now = FPlatformTime::Seconds();
+                SendDueReplies(Now);
+                if (Settings.GestureFps > 0.f && (Clients.Num() > 0 || ShmWriter.IsOpen() || UdpSocket != nullptr))
+                {
+                    const double Interval = 1.0 / Settings.GestureFps;
+
+                    // Past a quarter second behind, skip ahead instead of bursting a backlog at the client.
+                    if (Now - NextFrameTime > 0.25)
+                    {
+                        FramesBehind += static_cast<int64>((Now - NextFrameTime) / Interval);
+                        NextFrameTime = Now;
+                    }
+                    while (NextFrameTime <= Now)
+                    {
+                        SendFrame(NextFrameTime - ClockOrigin);
+                        NextFrameTime += Interval;
+                    }
+                }
+                else
+                {
+                    NextFrameTime = Now;
+                }
+
+                // Tearing down the listener is the only way to drop server-side connections through this API.
+                if (Settings.DisconnectIntervalSeconds > 0.f && Now - LastDisconnectTime >= Settings.DisconnectIntervalSeconds)
+                {
+                    LastDisconnectTime = Now;
+                    Disconnects += Clients.Num();
+                    DestroyServer();
+                    CreateServer();
+                }
+
+                const double SleepSeconds = FMath::Clamp(NextFrameTime - FPlatformTime::Seconds(), 0.0, 0.001);
+                FPlatformProcess::SleepNoStats(static_cast<float>(SleepSeconds));
+            }
+        }
+
+        /** The whole hand traces a slow circle so downstream mapping and hit testing see motion. */
+        static FVector3d GetMockLandmark(double Time, int32 HandIndex, int32 Landmark)
+        {
+            const double Angle = Time * 1.5 + HandIndex * UE_PI;
+            const double CenterX = 0.5 + 0.15 * FMath::Cos(Angle) + (HandIndex == 0 ? -0.1 : 0.1);
+            const double CenterY = 0.5 + 0.15 * FMath::Sin(Angle);
+            return FVector3d(CenterX + 0.02 * (Landmark % 5), CenterY - 0.03 * (Landmark / 4), -0.002 * Landmark);
+        }
+
+        static const TCHAR* GetMockHandedness(int32 HandIndex)
+        {
+            return HandIndex == 0 ? TEXT("Right") : TEXT("Left");
+        }
+
+        /** Writes the frame JSON into Frame; a non-zero mask sends only those landmarks, listed in a "landmarks" array. */
+        void BuildFrameJson(double Time, const FScriptStep& Current, int32 NumHands, uint32 LandmarkMask, int64 Sequence)
+        {
+            const bool bNested = Settings.PayloadShape == FFusionMockBackendSettings::EPayloadShape::NestedCoordinates;
+            const bool bSingle = Settings.PayloadShape == FFusionMockBackendSettings::EPayloadShape::SingleHand;
+
+            Frame.Reset();
+            Frame.Appendf(TEXT("{\"seq\":%lld,\"timestamp\":%.4f,\"gesture\":\"%s\""), Sequence, Time, *Current.Gesture);
+            if (!Current.ObjectId.IsEmpty())
+            {
+                Frame.Appendf(TEXT(",\"object_id\":\"%s\""), *Current.ObjectId);
+            }
+            if (!bSingle)
+            {
+                Frame.Append(TEXT(",\"hands\":["));
+            }
+
+            for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex)
+            {
+                Frame.Append(bSingle ? TEXT(",") : (HandIndex > 0 ? TEXT(",{") : TEXT("{")));
+                Frame.Appendf(TEXT("\"handedness\":\"%s\",\"state\":\"%s\","), GetMockHandedness(HandIndex), *Current.Gesture);
+
+                if (LandmarkMask != 0)
+                {
+                    Frame.Append(TEXT("\"landmarks\":["));
+                    bool bFirst = true;
+                    for (int32 Landmark = 0; Landmark < Settings.LandmarksPerHand; ++Landmark)
+                    {
+                        if (LandmarkMask & (1u << Landmark))
+                        {
+                            Frame.Appendf(TEXT("%s%d"), bFirst ? TEXT("") : TEXT(","), Landmark);
+                            bFirst = false;
+                        }
+                    }
+                    Frame.Append(TEXT("],"));
+                }
+
+                Frame.Append(TEXT("\"x_y_z\":["));
+                bool bFirst = true;
+                for (int32 Landmark = 0; Landmark < Settings.LandmarksPerHand; ++Landmark)
+                {
+                    if (LandmarkMask != 0 && !(LandmarkMask & (1u << Landmark)))
+                    {
+                        continue;
+                    }
+                    const FVector3d Location = GetMockLandmark(Time, HandIndex, Landmark);
+                    Frame.Appendf(bNested ? TEXT("%s[%.4f,%.4f,%.4f]") : TEXT("%s%.4f,%.4f,%.4f"), bFirst ? TEXT("") : TEXT(","), Location.X, Location.Y, Location.Z);
+                    bFirst = false;
+                }
+                Frame.Append(bSingle ? TEXT("]") : TEXT("]}"));
+            }
+
+            Frame.Append(bSingle ? TEXT("}") : TEXT("]}"));
+        }
+
+        void WriteSharedMemoryFrame(double Time, const FScriptStep& Current, int32 NumHands)
+        {
+            FusionGestureShm::FSlot& Slot = ShmWriter.BeginWrite();
+            Slot.CaptureTimestamp = Time;
+            FFusionSharedMemoryGestureWriter::WriteString(Slot.Gesture, UE_ARRAY_COUNT(Slot.Gesture), Current.Gesture);
+            FFusionSharedMemoryGestureWriter::WriteString(Slot.ObjectId, UE_ARRAY_COUNT(Slot.ObjectId), Current.ObjectId);
+            Slot.NumHands = FMath::Min(NumHands, FusionGestureShm::MaxHands);
+
+            for (uint32 HandIndex = 0; HandIndex < Slot.NumHands; ++HandIndex)
+            {
+                FusionGestureShm::FHand& Hand = Slot.Hands[HandIndex];
+                FFusionSharedMemoryGestureWriter::WriteString(Hand.State, UE_ARRAY_COUNT(Hand.State), Current.Gesture);
+                FFusionSharedMemoryGestureWriter::WriteString(Hand.Handedness, UE_ARRAY_COUNT(Hand.Handedness), GetMockHandedness(HandIndex));
+                Hand.NumLandmarks = FMath::Min(Settings.LandmarksPerHand, FusionGestureShm::MaxLandmarks);
+                for (uint32 Landmark = 0; Landmark < Hand.NumLandmarks; ++Landmark)
+                {
+                    const FVector3d Location = GetMockLandmark(Time, HandIndex, Landmark);
+                    Hand.Landmarks[Landmark * 3 + 0] = static_cast<float>(Location.X);
+                    Hand.Landmarks[Landmark * 3 + 1] = static_cast<float>(Location.Y);
+                    Hand.Landmarks[Landmark * 3 + 2] = static_cast<float>(Location.Z);
+                }
+            }
+            ShmWriter.EndWrite();
+        }
+
+        void SendFrame(double Time)
+        {
+            double ScriptLength = 0.0;
+            for (const FScriptStep& Step : Script)
+            {
+                ScriptLength += Step.Seconds;
+            }
+
+            const FScriptStep* Current = &Script[0];
+            double Cursor = FMath::Fmod(Time, ScriptLength);
+            for (const FScriptStep& Step : Script)
+            {
+                if (Cursor < Step.Seconds)
+                {
+                    Current = &Step;
+                    break;
+                }
+                Cursor -= Step.Seconds;
+            }
+
+            const bool bSingle = Settings.PayloadShape == FFusionMockBackendSettings::EPayloadShape::SingleHand;
+            const int32 NumHands = bSingle ? FMath::Min(1, Settings.HandsPerFrame) : Settings.HandsPerFrame;
+
+            if (ShmWriter.IsOpen())
+            {
+                WriteSharedMemoryFrame(Time, *Current, NumHands);
+            }
+
+            const bool bMalformed = Settings.GestureMalformedRate > 0.f && Random.FRand() < Settings.GestureMalformedRate;
+            if (bMalformed)
+            {
+                ++FramesMalformed;
+            }
+
+            // One payload per distinct landmark subscription and sequence; mask 0 is the full frame, also used for UDP.
+            TMap<TPair<uint32, int64>, TArray<uint8>> Payloads;
+            auto GetPayload = [this, &Payloads, Time, Current, NumHands, bMalformed](uint32 LandmarkMask, int64 Sequence) -> const TArray<uint8>&
+            {
+                const TPair<uint32, int64> Key(LandmarkMask, Sequence);
+                if (const TArray<uint8>* Existing = Payloads.Find(Key))
+                {
+                    return *Existing;
+                }
+                BuildFrameJson(Time, *Current, NumHands, LandmarkMask, Sequence);
+                const FTCHARToUTF8 Utf8(Frame.ToString(), Frame.Len());
+                TArray<uint8>& Payload = Payloads.Add(Key);
+                Payload.Append(reinterpret_cast<const uint8*>(Utf8.Get()), bMalformed ? Utf8.Length() / 2 : Utf8.Length());
+                return Payload;
+            };
+
+            const double HalfInterval = 0.5 / Settings.GestureFps;
+            for (const TSharedRef<FClient>& Client : Clients)
+            {
+                if (Client->RequestedFps > 0.0)
+                {
+                    if (Time + HalfInterval < Client->NextFrameTime)
+                    {
+                        continue;
+                    }
+                    Client->NextFrameTime = Time + 1.0 / Client->RequestedFps;
+                }
+                const TArray<uint8>& Payload = GetPayload(Client->LandmarkMask, Client->NextSequence++);
+                if (Settings.FramesPerMessage <= 1)
+                {
+                    Client->Socket->Send(Payload.GetData(), Payload.Num(), false);
+                    continue;
+                }
+
+                static constexpr ANSICHAR BatchPrefix[] = "{\"type\":\"frames\",\"frames\":[";
+                static constexpr ANSICHAR BatchSuffix[] = "]}";
+                TArray<uint8>& Batch = Client->PendingBatch;
+                if (Client->PendingBatchFrames == 0)
+                {
+                    Batch.Reset();
+                    Batch.Append(reinterpret_cast<const uint8*>(BatchPrefix), UE_ARRAY_COUNT(BatchPrefix) - 1);
+                }
+                else
+                {
+                    Batch.Add(',');
+                }
+                Batch.Append(Payload);
+
+                if (++Client->PendingBatchFrames >= Settings.FramesPerMessage)
+                {
+                    Batch.Append(reinterpret_cast<const uint8*>(BatchSuffix), UE_ARRAY_COUNT(BatchSuffix) - 1);
+                    Client->Socket->Send(Batch.GetData(), Batch.Num(), false);
+                    Client->PendingBatchFrames = 0;
+                }
+            }
+            if (UdpSocket)
+            {
+                const TArray<uint8>& Payload = GetPayload(0, FramesSent.load());
+                SendDatagram(Payload.GetData(), Payload.Num());
+            }
+            ++FramesSent;
+        }
+
+        bool OpenUdp(const FString& Target)
+        {
+            FIPv4Endpoint Endpoint;
+            if (!FIPv4Endpoint::Parse(Target, Endpoint))
+            {
+                UE_LOG(LogFusionMock, Warning, TEXT("UdpTarget '%s' is not an IPv4 host:port"), *Target);
+                return false;
+            }
+
+            UdpSocket = FUdpSocketBuilder(TEXT("FusionMockGestureUdp")).AsNonBlocking().Build();
+            if (!UdpSocket)
+            {
+                UE_LOG(LogFusionMock, Error, TEXT("Mock gesture server could not create a UDP socket"));
+                return false;
+            }
+            UdpAddress = Endpoint.ToInternetAddr();
+            return true;
+        }
+
+        void CloseUdp()
+        {
+            if (UdpSocket)
+            {
+                UdpSocket->Close();
+                ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(UdpSocket);
+                UdpSocket = nullptr;
+            }
+            UdpAddress.Reset();
+            HeldDatagram.Reset();
+        }
+
+        /** Sends one frame, applying the configured loss and reordering; a held-back frame goes out right after the next one. */
+        void SendDatagram(const uint8* Data, int32 Length)
+        {
+            if (Settings.UdpLossRate > 0.f && Random.FRand() < Settings.UdpLossRate)
+            {
+                ++DatagramsDropped;
+                return;
+            }
+
+            int32 BytesSent = 0;
+            if (HeldDatagram.Num() == 0 && Settings.UdpReorderRate > 0.f && Random.FRand() < Settings.UdpReorderRate)
+            {
+                HeldDatagram.Append(Data, Length);
+                ++DatagramsReordered;
+                return;
+            }
+
+            UdpSocket->SendTo(Data, Length, BytesSent, *UdpAddress);
+            if (HeldDatagram.Num() > 0)
+            {
+                UdpSocket->SendTo(HeldDatagram.GetData(), HeldDatagram.Num(), BytesSent, *UdpAddress);
+                HeldDatagram.Reset();
+            }
+        }
+
+        int32 Port = 0;
+        TUniquePtr<IWebSocketServer> Server;
+        TArray<TSharedRef<FClient>> Clients;
+        TUniquePtr<FThread> Thread;
+        std::atomic<bool> bStopping { false };
+
+        FCriticalSection SettingsLock;
+        FFusionMockBackendSettings PendingSettings;
+        int32 SettingsVersion = 0;
+
+        // Owned by the server thread.
+        FFusionMockBackendSettings Settings;
+        TArray<FScriptStep> Script;
+        FRandomStream Random;
+        TStringBuilder<4096> Frame;
+        TArray<FDelayedReply> DelayedReplies;
+        FFusionSharedMemoryGestureWriter ShmWriter;
+        FString ShmWriterName;
+        FSocket* UdpSocket = nullptr;
+        TSharedPtr<FInternetAddr> UdpAddress;
+        FString UdpTargetName;
+        TArray<uint8> HeldDatagram;
+
+        /** Zero of the tracker clock: frame timestamps and pong times count seconds from here. */
+        double ClockOrigin = 0.0;
+
+        std::atomic<int32> ConnectedClients { 0 };
+        std::atomic<int64> FramesSent { 0 };
+        std::atomic<int64> FramesBehind { 0 };
+        std::atomic<int64> FramesMalformed { 0 };
+        std::atomic<int64> Disconnects { 0 };
+        std::atomic<int64> SocketRequests { 0 };
+        std::atomic<int64> RateChanges { 0 };
+        std::atomic<int64> DatagramsDropped { 0 };
+        std::atomic<int64> DatagramsReordered { 0 };
+    };
+
+    class FRestServer
+    {
+    public:
+        ~FRestServer()
+        {
+            Stop();
+        }
+
+        bool Start(const FFusionMockBackendSettings& InSettings)
+        {
+            UpdateSettings(InSettings);
+
+            Router = FHttpServerModule::Get().GetHttpRouter(InSettings.RestPort, true);
+            if (!Router.IsValid())
+            {
+                UE_LOG(LogFusionMock, Error, TEXT("Mock REST server could not listen on port %d"), InSettings.RestPort);
+                return false;
+            }
+
+            bAlive = MakeShared<bool>(true);
+            Bind(TEXT("/descriptions"), EHttpServerRequestVerbs::VERB_POST, &FRestServer::HandleDescription);
+            Bind(TEXT("/descriptions/batch"), EHttpServerRequestVerbs::VERB_POST, &FRestServer::HandleDescriptionBatch);
+            Bind(TEXT("/voice-query"), EHttpServerRequestVerbs::VERB_POST, &FRestServer::HandleVoiceQuery);
+            Bind(TEXT("/tts"), EHttpServerRequestVerbs::VERB_GET, &FRestServer::HandleTts);
+
+            FHttpServerModule::Get().StartAllListeners();
+            return true;
+        }
+
+        void Stop()
+        {
+            // Delayed answers still sitting in the ticker are dropped; their connections time out on the client.
+            if (bAlive.IsValid())
+            {
+                *bAlive = false;
+                bAlive.Reset();
+            }
+
+            if (Router.IsValid())
+            {
+                for (const FHttpRouteHandle& Handle : RouteHandles)
+                {
+                    Router->UnbindRoute(Handle);
+                }
+                Router.Reset();
+            }
+            RouteHandles.Reset();
+        }
+
+        void UpdateSettings(const FFusionMockBackendSettings& InSettings)
+        {
+            Settings = InSettings;
+            Random.Initialize(Settings.Seed);
+        }
+
+        void LogStats() const
+        {
+            UE_LOG(LogFusionMock, Display, TEXT("REST: requests=%lld errors=%lld hangs=%lld malformed=%lld"), Requests, Errors, Hangs, Malformed);
+        }
+
+    private:
+        enum class EReplyKind : uint8
+        {
+            Ok,
+            Error,
+            Hang,
+            Malformed
+        };
+
+        using FHandler = bool (FRestServer::*)(const FHttpServerRequest&, const FHttpResultCallback&);
+
+        void Bind(const TCHAR* Path, EHttpServerRequestVerbs Verbs, FHandler Handler)
+        {
+            RouteHandles.Add(Router->BindRoute(FHttpPath(Path), Verbs, FHttpRequestHandler::CreateLambda(
+                [this, Handler](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+                {
+                    ++Requests;
+                    return (this->*Handler)(Request, OnComplete);
+                })));
+        }
+
+        static TSharedPtr<FJsonObject> ParseBody(const FHttpServerRequest& Request)
+        {
+            const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+            TSharedPtr<FJsonObject> Body;
+            FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get())), Body);
+            return Body;
+        }
+
+        static bool AcceptsEventStream(const FHttpServerRequest& Request)
+        {
+            for (const TPair<FString, TArray<FString>>& Header : Request.Headers)
+            {
+                if (Header.Key.Equals(TEXT("Accept"), ESearchCase::IgnoreCase))
+                {
+                    return Header.Value.ContainsByPredicate([](const FString& Value) { return Value.Contains(TEXT("text/event-stream")); });
+                }
+            }
+            return false;
+        }
+
+        void Reply(const FFusionMockLatency& Latency, const FFusionMockFailures& Failures, const FHttpResultCallback& OnComplete, FString Body, const FString& ContentType)
+        {
+            float Delay = Latency.Sample(Random);
+
+            EReplyKind Kind = EReplyKind::Ok;
+            const float Roll = Random.FRand();
+            if (Roll < Failures.ErrorRate)
+            {
+                Kind = EReplyKind::Error;
+                ++Errors;
+            }
+            else if (Roll < Failures.ErrorRate + Failures.HangRate)
+            {
+                Kind = EReplyKind::Hang;
+                Delay = HangSeconds;
+                ++Hangs;
+            }
+            else if (Roll < Failures.ErrorRate + Failures.HangRate + Failures.MalformedRate)
+            {
+                Kind = EReplyKind::Malformed;
+                Body.LeftInline(Body.Len() / 2);
+                ++Malformed;
+            }
+
+            auto Send = [OnComplete, Body = MoveTemp(Body), ContentType, Kind]()
+            {
+                if (Kind == EReplyKind::Error || Kind == EReplyKind::Hang)
+                {
+                    OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::ServerError, TEXT("mock_failure"), TEXT("Injected by the Fusion mock backend")));
+                    return;
+                }
+                OnComplete(FHttpServerResponse::Create(Body, ContentType));
+            };
+
+            if (Delay <= 0.f)
+            {
+                Send();
+                return;
+            }
+
+            TWeakPtr<bool> WeakAlive = bAlive;
+            FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakAlive, Send](float)
+            {
+                const TSharedPtr<bool> Alive = WeakAlive.Pin();
+                if (Alive.IsValid() && *Alive)
+                {
+                    Send();
+                }
+                return false;
+            }), Delay);
+        }
+
+        bool HandleDescription(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+        {
+            // Prefix routing sends /descriptions/batch here when batching is switched off; answer like a server without it.
+            if (!Request.RelativePath.IsEmpty())
+            {
+                OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::NotFound));
+                return true;
+            }
+
+            FString ObjectId;
+            if (const TSharedPtr<FJsonObject> Body = ParseBody(Request))
+            {
+                Body->TryGetStringField(TEXT("object_id"), ObjectId);
+            }
+
+            Reply(Settings.DescriptionLatency, Settings.DescriptionFailures, OnComplete, MakeDescriptionJson(ObjectId), TEXT("application/json"));
+            return true;
+        }
+
+        bool HandleDescriptionBatch(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+        {
+            if (!Settings.bSupportBatch)
+            {
+                OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::NotFound));
+                return true;
+            }
+
+            TArray<FString> Results;
+            const TArray<TSharedPtr<FJsonValue>>* Ids = nullptr;
+            const TSharedPtr<FJsonObject> Body = ParseBody(Request);
+            if (Body.IsValid() && Body->TryGetArrayField(TEXT("object_ids"), Ids) && Ids)
+            {
+                for (const TSharedPtr<FJsonValue>& Id : *Ids)
+                {
+                    Results.Add(MakeDescriptionJson(Id->AsString()));
+                }
+            }
+
+            Reply(Settings.DescriptionLatency, Settings.DescriptionFailures, OnComplete,
+                FString::Printf(TEXT("{\"results\":[%s]}"), *FString::Join(Results, TEXT(","))), TEXT("application/json"));
+            return true;
+        }
+
+        bool HandleVoiceQuery(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+        {
+            const FString Question = MakeVoiceQuestion(Requests, Request.Body.Num());
+            const TArray<FString> Tokens = MakeVoiceTokens(Settings.VoiceTokenCount);
+            const FString Answer = FString::Join(Tokens, TEXT(""));
+
+            if (!AcceptsEventStream(Request))
+            {
+                Reply(Settings.VoiceLatency, Settings.VoiceFailures, OnComplete,
+                    FString::Printf(TEXT("{\"user_question\":\"%s\",\"llm_result\":\"%s\"}"), *Question, *Answer), TEXT("application/json"));
+                return true;
+            }
+
+            // The HTTP server has no chunked responses, so the whole event stream arrives after the sampled latency.
+            FString Body = FString::Printf(TEXT("event: question\ndata: {\"user_question\":\"%s\"}\n\n"), *Question);
+            for (const FString& Token : Tokens)
+            {
+                Body += FString::Printf(TEXT("event: token\ndata: {\"token\":\"%s\"}\n\n"), *Token);
+            }
+            Body += FString::Printf(TEXT("event: answer\ndata: {\"llm_result\":\"%s\"}\n\ndata: [DONE]\n\n"), *Answer);
+
+            Reply(Settings.VoiceLatency, Settings.VoiceFailures, OnComplete, MoveTemp(Body), TEXT("text/event-stream"));
+            return true;
+        }
+
+        bool HandleTts(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+        {
+            // One second of 16-bit mono tone, pitched per path so different clips are distinguishable.
+            constexpr int32 SampleRate = 22050;
+            const float Frequency = 220.f + static_cast<float>(GetTypeHash(Request.RelativePath.GetPath()) % 440);
+
+            TArray<uint8> Wav;
+            const uint32 DataSize = SampleRate * sizeof(int16);
+            Wav.Reserve(44 + DataSize);
+            auto WriteTag = [&Wav](const char* Tag) { Wav.Append(reinterpret_cast<const uint8*>(Tag), 4); };
+            auto WriteU32 = [&Wav](uint32 Value) { for (int32 Shift = 0; Shift < 32; Shift += 8) { Wav.Add(static_cast<uint8>(Value >> Shift)); } };
+            auto WriteU16 = [&Wav](uint16 Value) { Wav.Add(static_cast<uint8>(Value)); Wav.Add(static_cast<uint8>(Value >> 8)); };
+
+            WriteTag("RIFF");
+            WriteU32(36 + DataSize);
+            WriteTag("WAVE");
+            WriteTag("fmt ");
+            WriteU32(16);
+            WriteU16(1);
+            WriteU16(1);
+            WriteU32(SampleRate);
+            WriteU32(SampleRate * sizeof(int16));
+            WriteU16(sizeof(int16));
+            WriteU16(16);
+            WriteTag("data");
+            WriteU32(DataSize);
+            for (int32 Sample = 0; Sample < SampleRate; ++Sample)
+            {
+                WriteU16(static_cast<uint16>(static_cast<int16>(8000.f * FMath::Sin(2.f * UE_PI * Frequency * Sample / SampleRate))));
+            }
+
+            OnComplete(FHttpServerResponse::Create(MoveTemp(Wav), TEXT("audio/wav")));
+            return true;
+        }
+
+        TSharedPtr<IHttpRouter> Router;
+        TArray<FHttpRouteHandle> RouteHandles;
+        TSharedPtr<bool> bAlive;
+
+        FFusionMockBackendSettings Settings;
+        FRandomStream Random;
+
+        int64 Requests = 0;
+        int64 Errors = 0;
+        int64 Hangs = 0;
+        int64 Malformed = 0;
+    };
+
+    static TUniquePtr<FGestureServer> GestureServer;
+    static TUniquePtr<FRestServer> RestServer;
+    static FFusionMockBackendSettings CurrentSettings;
+}
+
+bool FFusionMockBackend::Start(const FFusionMockBackendSettings& Settings)
+{
+    using namespace FusionMockBackend;
+    check(IsInGameThread());
+
+    Stop();
+
+    GestureServer = MakeUnique<FGestureServer>();
+    RestServer = MakeUnique<FRestServer>();
+    if (!GestureServer->Start(Settings) || !RestServer->Start(Settings))
+    {
+        Stop();
+        return false;
+    }
+
+    static bool bRegisteredExit = false;
+    if (!bRegisteredExit)
+    {
+        bRegisteredExit = true;
+        FCoreDelegates::OnEnginePreExit.AddStatic(&FFusionMockBackend::Stop);
+    }
+
+    CurrentSettings = Settings;
+    UE_LOG(LogFusionMock, Display, TEXT("Mock backend started: %s"), *Settings.ToString());
+    return true;
+}
+
+void FFusionMockBackend::Stop()
+{
+    using namespace FusionMockBackend;
+
+    if (GestureServer.IsValid() || RestServer.IsValid())
+    {
+        UE_LOG(LogFusionMock, Display, TEXT("Mock backend stopped."));
+    }
+    GestureServer.Reset();
+    RestServer.Reset();
+}
+
+bool FFusionMockBackend::IsRunning()
+{
+    return FusionMockBackend::GestureServer.IsValid() && FusionMockBackend::RestServer.IsValid();
+}
+
+void FFusionMockBackend::UpdateSettings(const FFusionMockBackendSettings& Settings)
+{
+    using namespace FusionMockBackend;
+
+    CurrentSettings = Settings;
+    if (IsRunning())
+    {
+        GestureServer->UpdateSettings(Settings);
+        RestServer->UpdateSettings(Settings);
+        UE_LOG(LogFusionMock, Display, TEXT("Mock backend updated: %s"), *Settings.ToString());
+    }
+}
+
+FFusionMockBackendSettings FFusionMockBackend::GetSettings()
+{
+    return FusionMockBackend::CurrentSettings;
+}
+
+void FFusionMockBackend::LogStats()
+{
+    using namespace FusionMockBackend;
+
+    if (!IsRunning())
+    {
+        UE_LOG(LogFusionMock, Display, TEXT("Mock backend is not running."));
+        return;
+    }
+    GestureServer->LogStats();
+    RestServer->LogStats();
+}
+
+static FAutoConsoleCommand GFusionMockStartCommand(
+    TEXT("Fusion.Mock.Start"),
+    TEXT("Starts the in-process gesture WebSocket and AI REST stand-ins. ")
+    TEXT("Args: Scenario=<file.json> GesturePort= RestPort= Seed= Fps= FramesPerMessage= Hands= Landmarks= Shape=hands|single|nested Script=point@colobus:1,fist:0.5 ")
+    TEXT("DisconnectEvery= GestureMalformedRate= SharedMemory=/fusion_gestures UdpTarget=127.0.0.1:8766 UdpLossRate= UdpReorderRate= DescLatency=lognormal:0.3:0.5 VoiceLatency=uniform:1:0.5 ")
+    TEXT("DescErrorRate= DescHangRate= DescMalformedRate= VoiceErrorRate= VoiceHangRate= VoiceMalformedRate= VoiceTokens= Batch= SocketRequests="),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        FFusionMockBackendSettings Settings;
+        Settings.ApplyArgs(Args);
+        FFusionMockBackend::Start(Settings);
+    }));
+
+static FAutoConsoleCommand GFusionMockSetCommand(
+    TEXT("Fusion.Mock.Set"),
+    TEXT("Changes settings of the running mock backend; same args as Fusion.Mock.Start."),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        FFusionMockBackendSettings Settings = FFusionMockBackend::GetSettings();
+        Settings.ApplyArgs(Args);
+        FFusionMockBackend::UpdateSettings(Settings);
+    }));
+
+static FAutoConsoleCommand GFusionMockStopCommand(
+    TEXT("Fusion.Mock.Stop"),
+    TEXT("Stops the in-process mock backend."),
+    FConsoleCommandDelegate::CreateStatic(&FFusionMockBackend::Stop));
+
+static FAutoConsoleCommand GFusionMockStatsCommand(
+    TEXT("Fusion.Mock.Stats"),
+    TEXT("Logs frames sent, injected failures and connected clients of the mock backend."),
+    FConsoleCommandDelegate::CreateStatic(&FFusionMockBackend::LogStats));
+
+#endif
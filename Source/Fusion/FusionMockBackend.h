@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_FUSION_MOCK_BACKEND
+
+/** How long a mock endpoint waits before answering. */
+struct FFusionMockLatency
+{
+    enum class EDistribution : uint8
+    {
+        Constant,
+        Uniform,
+        LogNormal
+    };
+
+    EDistribution Distribution = EDistribution::Constant;
+    float MeanSeconds = 0.f;
+
+    /** Half-width for Uniform, sigma of the underlying normal for LogNormal. */
+    float Spread = 0.f;
+
+    /** Parses "constant:0.2", "uniform:0.5:0.3" or "lognormal:0.4:0.8". */
+    bool Parse(const FString& Spec);
+    float Sample(FRandomStream& Random) const;
+};
+
+/** Per-endpoint failure injection; each rate is an independent probability per request. */
+struct FFusionMockFailures
+{
+    float ErrorRate = 0.f;
+    float HangRate = 0.f;
+    float MalformedRate = 0.f;
+};
+
+struct FFusionMockBackendSettings
+{
+    enum class EPayloadShape : uint8
+    {
+        /** {"hands":[{"state":..,"x_y_z":[..]}]} */
+        Hands,
+        /** {"state":..,"x_y_z":[..]} at the top level */
+        SingleHand,
+        /** "hands" with x_y_z as [[x,y,z],..] */
+        NestedCoordinates
+    };
+
+    int32 GesturePort = 8765;
+    int32 RestPort = 8000;
+    int32 Seed = 0;
+
+    float GestureFps = 30.f;
+
+    /** Frames per WebSocket message; above 1 frames go out as {"type":"frames","frames":[..]} batches. UDP stays unbatched. */
+    int32 FramesPerMessage = 1;
+    int32 HandsPerFrame = 1;
+    int32 LandmarksPerHand = 21;
+    EPayloadShape PayloadShape = EPayloadShape::Hands;
+
+    /** Cycled gesture steps, "gesture[@object_id]:seconds". */
+    TArray<FString> GestureScript;
+
+    /** Also publishes every frame to this POSIX shared-memory gesture ring (Linux; empty = off). */
+    FString SharedMemoryName;
+
+    /** Also sends every frame as a UDP datagram to "host:port" (empty = off). */
+    FString UdpTarget;
+
+    /** Probability that a datagram is dropped, and that it is held back and sent after the next one. */
+    float UdpLossRate = 0.f;
+    float UdpReorderRate = 0.f;
+
+    /** Drops every gesture client after this many seconds (0 = never). */
+    float DisconnectIntervalSeconds = 0.f;
+    float GestureMalformedRate = 0.f;
+
+    FFusionMockLatency DescriptionLatency;
+    FFusionMockLatency VoiceLatency;
+    FFusionMockFailures DescriptionFailures;
+    FFusionMockFailures VoiceFailures;
+
+    bool bSupportBatch = true;
+
+    /** Answers describe and voice_query requests sent over the gesture socket; otherwise replies "unsupported". */
+    bool bSupportSocketRequests = true;
+    int32 VoiceTokenCount = 12;
+
+    /** Applies "Key=Value" tokens on top of the current values; Scenario=<file.json> loads the same keys from JSON first. */
+    void ApplyArgs(const TArray<FString>& Args);
+    FString ToString() const;
+};
+
+/**
+ * In-process stand-in for the MediaPipe gesture WebSocket and the AI REST server, so AFusionMode can be exercised
+ * at high frame rates or against slow and failing backends without a camera or the Python services.
+ * Development builds only; start it from AFusionMode (bStartMockBackend) or with the Fusion.Mock.* console commands.
+ */
+class FUSION_API FFusionMockBackend
+{
+public:
+    static bool Start(const FFusionMockBackendSettings& Settings);
+    static void Stop();
+    static bool IsRunning();
+
+    /** Replaces the settings of a running backend; ports only take effect on the next Start. */
+    static void UpdateSettings(const FFusionMockBackendSettings& Settings);
+    static FFusionMockBackendSettings GetSettings();
+
+    static void LogStats();
+};
+
+#endif
@@ -12,14 +12,172 @@
 #include "Misc/FileHelper.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "Dom/JsonValue.h"
 #include "WebSocketsModule.h"
 #include "IWebSocket.h"
+#include "FusionDebugOverlay.h"
+#include "FusionRequestScheduler.h"
+#include "FusionRequestTelemetry.h"
+#include "FusionSocketChannel.h"
+#include "FusionGestureSource.h"
+#include "FusionGestureSequenceTracker.h"
+#include "FusionSharedMemoryGestureSource.h"
+#include "FusionUdpGestureSource.h"
+#include "FusionVoiceAnswerStream.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
 #include "HandViewportMapperComponent.h"
+#include "FusionTtsComponent.h"
+#include "FusionMockBackend.h"
 #include "Components/Widget.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogFusionMode, Log, All);
 
+// REST bodies are decoded on a worker; only these small structs travel back to the game thread.
+namespace FusionResponse
+{
+    struct FDescription
+    {
+        FString ObjectId;
+        FString Description;
+        FString TtsUrl;
+    };
+
+    struct FVoiceAnswer
+    {
+        FString Question;
+        FString Answer;
+    };
+
+    static TSharedPtr<FJsonValue> ParseJson(const FString& Text)
+    {
+        TSharedPtr<FJsonValue> Root;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+        FJsonSerializer::Deserialize(Reader, Root);
+        return Root;
+    }
+
+    static TSharedPtr<FJsonValue> ParseJson(const TArray<uint8>& Bytes)
+    {
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+        return ParseJson(FString(Converted.Length(), Converted.Get()));
+    }
+
+    static void ReadDescription(const FJsonObject& Object, FDescription& OutDescription)
+    {
+        Object.TryGetStringField(TEXT("object_id"), OutDescription.ObjectId);
+        Object.TryGetStringField(TEXT("description"), OutDescription.Description);
+        Object.TryGetStringField(TEXT("tts_url"), OutDescription.TtsUrl);
+    }
+
+    static bool DecodeDescription(const TArray<uint8>& Bytes, FDescription& OutDescription)
+    {
+        const TSharedPtr<FJsonValue> Root = ParseJson(Bytes);
+        const TSharedPtr<FJsonObject> Object = Root.IsValid() ? Root->AsObject() : nullptr;
+        if (!Object.IsValid())
+        {
+            return false;
+        }
+
+        ReadDescription(*Object, OutDescription);
+        return true;
+    }
+
+    /** Accepts a bare array or {"results": [...]}. */
+    static bool DecodeDescriptionBatch(const TArray<uint8>& Bytes, TArray<FDescription>& OutDescriptions)
+    {
+        const TSharedPtr<FJsonValue> Root = ParseJson(Bytes);
+        if (!Root.IsValid())
+        {
+            return false;
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* Results = nullptr;
+        if (!Root->TryGetArray(Results))
+        {
+            const TSharedPtr<FJsonObject> RootObject = Root->AsObject();
+            if (!RootObject.IsValid() || !RootObject->TryGetArrayField(TEXT("results"), Results))
+            {
+                return false;
+            }
+        }
+
+        OutDescriptions.Reserve(Results->Num());
+        for (const TSharedPtr<FJsonValue>& ResultValue : *Results)
+        {
+            const TSharedPtr<FJsonObject>* ResultObject = nullptr;
+            if (ResultValue.IsValid() && ResultValue->TryGetObject(ResultObject) && ResultObject)
+            {
+                ReadDescription(**ResultObject, OutDescriptions.AddDefaulted_GetRef());
+            }
+        }
+        return true;
+    }
+
+    static bool DecodeVoiceAnswer(const TSharedPtr<FJsonValue>& Root, FVoiceAnswer& OutAnswer)
+    {
+        const TSharedPtr<FJsonObject> Object = Root.IsValid() ? Root->AsObject() : nullptr;
+        if (!Object.IsValid())
+        {
+            return false;
+        }
+
+        Object->TryGetStringField(TEXT("user_question"), OutAnswer.Question);
+        Object->TryGetStringField(TEXT("llm_result"), OutAnswer.Answer);
+        return true;
+    }
+}
+
+void FFusionCancellationToken::Cancel()
+{
+    TArray<TFunction<void()>> ToRun;
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (bCancelled)
+        {
+            return;
+        }
+        bCancelled = true;
+        ToRun = MoveTemp(Callbacks);
+    }
+
+    if (ToRun.Num() == 0)
+    {
+        return;
+    }
+
+    auto RunCallbacks = [ToRun = MoveTemp(ToRun)]()
+    {
+        for (const TFunction<void()>& Callback : ToRun)
+        {
+            Callback();
+        }
+    };
+
+    if (IsInGameThread())
+    {
+        RunCallbacks();
+    }
+    else
+    {
+        AsyncTask(ENamedThreads::GameThread, MoveTemp(RunCallbacks));
+    }
+}
+
+void FFusionCancellationToken::OnCancelled(TFunction<void()>&& Callback)
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (!bCancelled)
+        {
+            Callbacks.Add(MoveTemp(Callback));
+            return;
+        }
+    }
+    Callback();
+}
+
 FColor AFusionMode::GetLogColor(ELogVerbosity::Type Verbosity) const
 {
     switch (Verbosity)
@@ -56,31 +214,186 @@ void AFusionMode::LogOnScreen(ELogVerbosity::Type Verbosity, const TCHAR* Format
 
 AFusionMode::AFusionMode()
 {
+    PrimaryActorTick.bCanEverTick = true;
+
     GestureStreamUrl = TEXT("ws://127.0.0.1:8765/gesture_stream");
+    GestureTransport = EFusionGestureTransport::WebSocket;
+    GestureSharedMemoryName = TEXT("/fusion_gestures");
+    GestureUdpPort = 8766;
+    GestureUdpBindAddress = TEXT("127.0.0.1");
     DescribeEndpoint = TEXT("http://127.0.0.1:8000/descriptions");
+    DescribeBatchEndpoint = TEXT("http://127.0.0.1:8000/descriptions/batch");
+    DescriptionBatchWindowSeconds = 0.05f;
+    MaxDescriptionBatchSize = 20;
     VoiceQueryEndpoint = TEXT("http://127.0.0.1:8000/voice-query");
     GestureKeepAliveInterval = 5.f;
+    GestureStreamFps = 0.f;
+    GestureIdleFps = 2.f;
+    GestureIdleDelaySeconds = 3.f;
+    GestureDescriptionFps = 5.f;
+    bStreamVoiceAnswers = true;
+    bMultiplexRequestsOverGestureSocket = false;
+    MaxConcurrentRequestsPerEndpoint = 2;
+    DescriptionDeadlineSeconds = 10.f;
+    VoiceQueryDeadlineSeconds = 30.f;
+    DescriptionMaxRetries = 2;
+    DescriptionRetryBaseDelaySeconds = 0.25f;
+    CircuitBreakerFailureThreshold = 5;
+    CircuitBreakerOpenSeconds = 10.f;
+    HedgePercentile = 0.95f;
+    HedgeMinDelaySeconds = 0.05f;
+    HedgeFallbackDelaySeconds = 0.5f;
+    MaxCachedDescriptions = 128;
+    bStartMockBackend = false;
 
     HandViewportMapper = CreateDefaultSubobject<UHandViewportMapperComponent>(TEXT("HandViewportMapper"));
+    TtsComponent = CreateDefaultSubobject<UFusionTtsComponent>(TEXT("TtsComponent"));
 }
 
 void AFusionMode::BeginPlay()
 {
     Super::BeginPlay();
 
+    RequestScheduler = MakeShared<FFusionRequestScheduler>(MaxConcurrentRequestsPerEndpoint);
+    RequestScheduler->SetCircuitBreakerSettings({ CircuitBreakerFailureThreshold, CircuitBreakerOpenSeconds });
+    RequestScheduler->SetHedgingSettings({ HedgeMinDelaySeconds, HedgeFallbackDelaySeconds });
+
+    TWeakObjectPtr<AFusionMode> WeakThis = this;
+    RequestScheduler->OnCircuitStateChanged = [WeakThis](const FString& Endpoint, EFusionCircuitState State)
+    {
+        if (AFusionMode* StrongThis = WeakThis.Get())
+        {
+            StrongThis->HandleCircuitStateChanged(Endpoint, State);
+        }
+    };
+
+    // Fine-grained so hedge delays and retry backoff of a few tens of milliseconds are honoured.
+    GetWorldTimerManager().SetTimer(RequestSchedulerTickHandle, this, &AFusionMode::TickRequestScheduler, 0.02f, true);
+
+    // Relative tts_url values are served by the same host as the description endpoint.
+    if (TtsComponent)
+    {
+        FString BaseUrl = DescribeEndpoint;
+        const int32 SchemeEnd = BaseUrl.Find(TEXT("://"));
+        const int32 PathStart = SchemeEnd == INDEX_NONE ? INDEX_NONE : BaseUrl.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, SchemeEnd + 3);
+        if (PathStart != INDEX_NONE)
+        {
+            BaseUrl.LeftInline(PathStart);
+        }
+        TtsComponent->SetBaseUrl(BaseUrl);
+    }
+
+#if WITH_FUSION_MOCK_BACKEND
+    if (bStartMockBackend && !FFusionMockBackend::IsRunning())
+    {
+        TArray<FString> MockArgs;
+        MockBackendArgs.ParseIntoArrayWS(MockArgs);
+
+        FFusionMockBackendSettings MockSettings;
+        MockSettings.ApplyArgs(MockArgs);
+        bOwnsMockBackend = FFusionMockBackend::Start(MockSettings);
+        if (!bOwnsMockBackend)
+        {
+            LogOnScreen(ELogVerbosity::Error, TEXT("Mock backend failed to start; see LogFusionMock."));
+        }
+    }
+#endif
+
+    if (GestureTransport == EFusionGestureTransport::SharedMemory)
+    {
+        GestureSource = MakeShared<FFusionSharedMemoryGestureSource>(GestureSharedMemoryName);
+        LogOnScreen(ELogVerbosity::Log, TEXT("Reading gesture frames from shared memory %s"), *GestureSharedMemoryName);
+    }
+    else if (GestureTransport == EFusionGestureTransport::Udp)
+    {
+        GestureSource = MakeShared<FFusionUdpGestureSource>(GestureUdpBindAddress, GestureUdpPort);
+        LogOnScreen(ELogVerbosity::Log, TEXT("Reading gesture frames from UDP %s:%d"), *GestureUdpBindAddress, GestureUdpPort);
+    }
+
+    DefaultGestureStreamName = GestureSource.IsValid() ? GestureSource->GetName() : TEXT("WebSocket");
+    LastHandSeenTime = FPlatformTime::Seconds();
+    if (HandViewportMapper)
+    {
+        HandViewportMapper->OnStateChanged.AddDynamic(this, &AFusionMode::HandleMapperStateChanged);
+    }
+
+    SocketChannel = MakeShared<FFusionSocketChannel>();
     InitializeGestureWebSocket();
     ScheduleGestureKeepAlive();
 }
 
 void AFusionMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+    // Cancelled before the socket goes away so nothing falls back to HTTP during teardown.
+    if (SocketChannel.IsValid())
+    {
+        SocketChannel->FailAll(EFusionRequestOutcome::Cancelled);
+        SocketChannel.Reset();
+    }
+
     ShutdownGestureWebSocket();
+    GestureSource.Reset();
     GetWorldTimerManager().ClearTimer(GestureKeepAliveHandle);
     GetWorldTimerManager().ClearTimer(GestureReconnectHandle);
+    GetWorldTimerManager().ClearTimer(RequestSchedulerTickHandle);
+    GetWorldTimerManager().ClearTimer(DescriptionBatchHandle);
+    PendingDescriptionBatch.Reset();
+    DescriptionBatchKeys.Reset();
+
+    if (RequestScheduler.IsValid())
+    {
+        RequestScheduler->CancelAll();
+        RequestScheduler.Reset();
+    }
+
+    // Futures still waiting (e.g. on a batch window that never flushed) must not be left unresolved.
+    TArray<FString> WaitingObjectIds;
+    DescriptionWaiters.GetKeys(WaitingObjectIds);
+    for (const FString& ObjectId : WaitingObjectIds)
+    {
+        FailDescriptionWaiters(ObjectId, EFusionRequestOutcome::Cancelled);
+    }
+    FailVoiceAnswer(EFusionRequestOutcome::Cancelled);
+
+#if WITH_FUSION_MOCK_BACKEND
+    if (bOwnsMockBackend)
+    {
+        FFusionMockBackend::Stop();
+        bOwnsMockBackend = false;
+    }
+#endif
 
     Super::EndPlay(EndPlayReason);
 }
 
+void AFusionMode::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    PollGestureSource();
+
+    if (DeltaSeconds > 0.f)
+    {
+        SmoothedGameFps = SmoothedGameFps > 0.f ? FMath::Lerp(SmoothedGameFps, 1.f / DeltaSeconds, 0.05f) : 1.f / DeltaSeconds;
+    }
+    UpdateGestureStreamRate();
+}
+
+void AFusionMode::PollGestureSource()
+{
+    if (!GestureSource.IsValid())
+    {
+        return;
+    }
+
+    TArray<FFusionGestureFrame> Frames;
+    GestureSource->Poll(Frames);
+    for (const FFusionGestureFrame& Frame : Frames)
+    {
+        ProcessGestureFrame(Frame);
+    }
+}
+
 void AFusionMode::InitializeGestureWebSocket()
 {
     if (GestureStreamUrl.IsEmpty())
@@ -101,8 +414,14 @@ void AFusionMode::InitializeGestureWebSocket()
     GestureSocket->OnConnected().AddUObject(this, &AFusionMode::HandleWebSocketConnected);
     GestureSocket->OnConnectionError().AddUObject(this, &AFusionMode::HandleWebSocketConnectionError);
     GestureSocket->OnMessage().AddUObject(this, &AFusionMode::HandleWebSocketMessage);
+    GestureSocket->OnBinaryMessage().AddUObject(this, &AFusionMode::HandleWebSocketBinaryMessage);
     GestureSocket->OnClosed().AddUObject(this, &AFusionMode::HandleWebSocketClosed);
 
+    if (SocketChannel.IsValid())
+    {
+        SocketChannel->SetSocket(GestureSocket);
+    }
+
     LogOnScreen(ELogVerbosity::Log, TEXT("Connecting to gesture WebSocket: %s"), *GestureStreamUrl);
     GestureSocket->Connect();
 }
@@ -114,6 +433,7 @@ void AFusionMode::ShutdownGestureWebSocket()
         GestureSocket->OnConnected().RemoveAll(this);
         GestureSocket->OnConnectionError().RemoveAll(this);
         GestureSocket->OnMessage().RemoveAll(this);
+        GestureSocket->OnBinaryMessage().RemoveAll(this);
         GestureSocket->OnClosed().RemoveAll(this);
 
         if (GestureSocket->IsConnected())
@@ -123,11 +443,24 @@ void AFusionMode::ShutdownGestureWebSocket()
 
         GestureSocket.Reset();
     }
+
+    if (SocketChannel.IsValid())
+    {
+        SocketChannel->SetSocket(nullptr);
+        SocketChannel->FailAll(EFusionRequestOutcome::Failed);
+    }
+
+    GestureBinaryBuffer.Reset();
 }
 
 void AFusionMode::HandleWebSocketConnected()
 {
     LogOnScreen(ELogVerbosity::Log, TEXT("Gesture WebSocket connected."));
+    SendGestureSubscription();
+
+    // The server may be a different tracker host now; start over with a quick burst of pings.
+    TrackerClock.Reset();
+    SendGestureKeepAlive();
 }
 
 void AFusionMode::HandleWebSocketConnectionError(const FString& Error)
@@ -138,64 +471,119 @@ void AFusionMode::HandleWebSocketConnectionError(const FString& Error)
 void AFusionMode::HandleWebSocketMessage(const FString& Message)
 {
     // LogOnScreen(ELogVerbosity::Verbose, TEXT("Gesture message received: %s"), *Message);
-    OnGesturePayloadReceived.Broadcast(Message);
-
     TSharedPtr<FJsonObject> JsonPayload;
     const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
-    if (!FJsonSerializer::Deserialize(Reader, JsonPayload) || !JsonPayload.IsValid())
+    const bool bParsed = FJsonSerializer::Deserialize(Reader, JsonPayload) && JsonPayload.IsValid();
+    if (bParsed && HandleSocketChannelMessage(*JsonPayload))
+    {
+        return;
+    }
+
+    // Another transport delivers the frames; whatever the server still streams here would duplicate them.
+    if (GestureTransport != EFusionGestureTransport::WebSocket)
     {
         return;
     }
-    TArray<FFusionHandSnapshot> ParsedHands;
-    PopulateHandsFromJson(JsonPayload, ParsedHands);
-    OnGestureFrameReceived.Broadcast(ParsedHands);
-    // if (ParsedHands.Num() > 0)
-    // {
-    //     FFusionWidgetHitResult HitResult;
-    //     HandViewportMapper->FindWidgetAlongDirection(ParsedHands[0],7,8,1000,HitResult);
-    // }
 
-    FString ParsedGesture;
-    JsonPayload->TryGetStringField(TEXT("gesture"), ParsedGesture);
-    if (ParsedGesture.IsEmpty())
+    OnGesturePayloadReceived.Broadcast(Message);
+    if (!bParsed)
+    {
+        return;
+    }
+
+    // One message may carry a batch of frames; each goes through the pipeline on its own, in capture order.
+    TArray<FFusionGestureFrame> Frames;
+    FusionGestureJson::ParseFrames(*JsonPayload, Frames);
+    for (const FFusionGestureFrame& Frame : Frames)
     {
-        JsonPayload->TryGetStringField(TEXT("hand_state"), ParsedGesture);
+        ProcessGestureFrame(Frame);
     }
+}
 
-    FString ParsedHand;
-    JsonPayload->TryGetStringField(TEXT("hand"), ParsedHand);
-    if (ParsedHand.IsEmpty())
+void AFusionMode::ProcessGestureFrame(const FFusionGestureFrame& Frame)
+{
+    if (Frame.Hands.Num() > 0)
     {
-        JsonPayload->TryGetStringField(TEXT("handedness"), ParsedHand);
+        // Checked right away so an idle stream speeds up on the first frame with a hand, not on the next tick.
+        LastHandSeenTime = FPlatformTime::Seconds();
+        if (SentGestureStreamMode.IsSet() && SentGestureStreamMode.GetValue() == EGestureStreamMode::Idle)
+        {
+            UpdateGestureStreamRate();
+        }
     }
 
-    FString ParsedObjectHint;
-    JsonPayload->TryGetStringField(TEXT("object_id"), ParsedObjectHint);
-    if (ParsedObjectHint.IsEmpty())
+    CurrentGestureFrameTimestamp = Frame.CaptureTimestamp;
+
+    const FString& StreamName = Frame.Source.IsEmpty() ? DefaultGestureStreamName : Frame.Source;
+    TSharedPtr<FFusionGestureSequenceTracker>& Tracker = GestureSequenceTrackers.FindOrAdd(StreamName);
+    if (!Tracker.IsValid())
     {
-        JsonPayload->TryGetStringField(TEXT("object_hint"), ParsedObjectHint);
+        Tracker = MakeShared<FFusionGestureSequenceTracker>();
     }
+    const double Now = FPlatformTime::Seconds();
+    const bool bHasLatency = TrackerClock.HasEstimate() && Frame.CaptureTimestamp > 0.0;
+    Tracker->Record(Frame.Sequence, Now, bHasLatency ? Now - TrackerClock.ToLocalTime(Frame.CaptureTimestamp) : -1.0);
+
+    OnGestureFrameReceived.Broadcast(Frame.Hands);
+    // if (Frame.Hands.Num() > 0)
+    // {
+    //     FFusionWidgetHitResult HitResult;
+    //     HandViewportMapper->FindWidgetAlongDirection(Frame.Hands[0],7,8,1000,HitResult);
+    // }
 
-    const bool bIsPointGesture = ParsedGesture.Equals(TEXT("point"), ESearchCase::IgnoreCase)
-        || ParsedGesture.Equals(TEXT("select"), ESearchCase::IgnoreCase);
-    if (bIsPointGesture && !ParsedObjectHint.IsEmpty())
+    const bool bIsPointGesture = Frame.Gesture.Equals(TEXT("point"), ESearchCase::IgnoreCase)
+        || Frame.Gesture.Equals(TEXT("select"), ESearchCase::IgnoreCase);
+    if (bIsPointGesture && !Frame.ObjectHint.IsEmpty())
     {
-        RequestObjectDescription(ParsedObjectHint);
+        RequestObjectDescription(Frame.ObjectHint);
     }
 
-    const bool bIsBackGesture = ParsedGesture.Equals(TEXT("fist"), ESearchCase::IgnoreCase)
-        || ParsedGesture.Equals(TEXT("back"), ESearchCase::IgnoreCase)
-        || ParsedHand.Equals(TEXT("fist"), ESearchCase::IgnoreCase);
+    const bool bIsBackGesture = Frame.Gesture.Equals(TEXT("fist"), ESearchCase::IgnoreCase)
+        || Frame.Gesture.Equals(TEXT("back"), ESearchCase::IgnoreCase)
+        || Frame.Hand.Equals(TEXT("fist"), ESearchCase::IgnoreCase);
     if (bIsBackGesture)
     {
         BroadcastBackToUI();
     }
 }
 
+void AFusionMode::HandleWebSocketBinaryMessage(const void* Data, SIZE_T Size, bool bIsLastFragment)
+{
+    GestureBinaryBuffer.Append(static_cast<const uint8*>(Data), static_cast<int32>(Size));
+    if (!bIsLastFragment)
+    {
+        return;
+    }
+
+    // Framed binary messages carry a JSON header for the request channel; only the header is used on this side.
+    FString FrameHeader;
+    TConstArrayView<uint8> FramePayload;
+    if (FFusionSocketChannel::DecodeBinaryFrame(GestureBinaryBuffer, FrameHeader, FramePayload))
+    {
+        GestureBinaryBuffer.Reset();
+        HandleWebSocketMessage(FrameHeader);
+        return;
+    }
+
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(GestureBinaryBuffer.GetData()), GestureBinaryBuffer.Num());
+    const FString Message(Converted.Length(), Converted.Get());
+    GestureBinaryBuffer.Reset();
+
+    HandleWebSocketMessage(Message);
+}
+
 void AFusionMode::HandleWebSocketClosed(int32 StatusCode, const FString& Reason, bool bWasClean)
 {
     LogOnScreen(ELogVerbosity::Warning, TEXT("Gesture WebSocket closed (code=%d, clean=%s): %s"), StatusCode, bWasClean ? TEXT("true") : TEXT("false"), *Reason);
 
+    SentGestureStreamMode.Reset();
+
+    // Requests waiting on the socket are resent over HTTP rather than waiting for the reconnect.
+    if (SocketChannel.IsValid())
+    {
+        SocketChannel->FailAll(EFusionRequestOutcome::Failed);
+    }
+
     if (UWorld* World = GetWorld())
     {
         FTimerDelegate ReconnectDelegate;
@@ -227,236 +615,1363 @@ void AFusionMode::SendGestureKeepAlive()
         return;
     }
 
-    static const FString PingPayload = TEXT("{\"type\":\"ping\"}");
-    GestureSocket->Send(PingPayload);
+    // Trackers echo t0 and add t1 (ping received) and t2 (pong sent) on their own clock; see FFusionClockSync.
+    GestureSocket->Send(FString::Printf(TEXT("{\"type\":\"ping\",\"t0\":%.6f}"), FPlatformTime::Seconds()));
 }
 
-void AFusionMode::PopulateHandsFromJson(const TSharedPtr<FJsonObject>& JsonPayload, TArray<FFusionHandSnapshot>& OutHands) const
+void AFusionMode::HandleGesturePong(const FJsonObject& Message)
 {
-    OutHands.Reset();
-
-    if (!JsonPayload.IsValid())
+    const double ReceiveTime = FPlatformTime::Seconds();
+
+    // Servers that only answer {"type":"pong"} keep the connection alive but give no clock estimate.
+    double SendTime = 0.0;
+    double TrackerReceiveTime = 0.0;
+    double TrackerSendTime = 0.0;
+    if (!Message.TryGetNumberField(TEXT("t0"), SendTime) || !Message.TryGetNumberField(TEXT("t1"), TrackerReceiveTime)
+        || !Message.TryGetNumberField(TEXT("t2"), TrackerSendTime))
     {
         return;
     }
 
-    TArray<TSharedPtr<FJsonObject>> HandObjects;
+    TrackerClock.AddSample(SendTime, TrackerReceiveTime, TrackerSendTime, ReceiveTime);
 
-    const TArray<TSharedPtr<FJsonValue>>* HandsArray = nullptr;
-    if (JsonPayload->TryGetArrayField(TEXT("hands"), HandsArray) && HandsArray)
+    // A few exchanges back to back right after connecting, so the estimate does not wait for the keep-alive timer.
+    constexpr int32 InitialClockSamples = 4;
+    if (TrackerClock.GetSampleCount() < InitialClockSamples)
     {
-        for (const TSharedPtr<FJsonValue>& HandValue : *HandsArray)
-        {
-            const TSharedPtr<FJsonObject> HandObject = HandValue.IsValid() ? HandValue->AsObject() : nullptr;
-            if (HandObject.IsValid())
-            {
-                HandObjects.Add(HandObject);
-            }
-        }
+        SendGestureKeepAlive();
     }
-    else
-    {
-        TSharedPtr<FJsonObject> SingleHandObject;
-        if (JsonPayload->HasTypedField<EJson::Object>(TEXT("hand")))
-        {
-            SingleHandObject = JsonPayload->GetObjectField(TEXT("hand"));
-        }
-        else if (JsonPayload->HasField(TEXT("x_y_z")) || JsonPayload->HasField(TEXT("state")))
-        {
-            SingleHandObject = JsonPayload;
-        }
+}
 
-        if (SingleHandObject.IsValid())
-        {
-            HandObjects.Add(SingleHandObject);
-        }
+namespace
+{
+    /** Rates requested while tracking follow the game frame rate in steps of this many fps, so jitter sends nothing. */
+    constexpr float GestureStreamFpsStep = 5.f;
+
+    /** Minimum seconds between rate changes within one mode; changing modes is always sent at once. */
+    constexpr double GestureStreamRateHoldSeconds = 1.0;
+}
+
+void AFusionMode::SendGestureSubscription()
+{
+    if (!GestureSocket.IsValid() || !GestureSocket->IsConnected())
+    {
+        return;
     }
 
-    if (HandObjects.Num() == 0)
+    SentGestureStreamMode.Reset();
+    UpdateGestureStreamRate();
+}
+
+void AFusionMode::UpdateGestureStreamRate()
+{
+    if (!GestureSocket.IsValid() || !GestureSocket->IsConnected())
     {
         return;
     }
 
-    OutHands.Reserve(HandObjects.Num());
+    const double Now = FPlatformTime::Seconds();
 
-    for (const TSharedPtr<FJsonObject>& HandObject : HandObjects)
+    EGestureStreamMode Mode = EGestureStreamMode::Active;
+    float Fps = GestureStreamFps;
+    if (bMapperInDescription)
     {
-        if (!HandObject.IsValid())
+        Mode = EGestureStreamMode::Description;
+        Fps = GestureDescriptionFps;
+    }
+    else if (GestureIdleDelaySeconds > 0.f && Now - LastHandSeenTime >= GestureIdleDelaySeconds)
+    {
+        Mode = EGestureStreamMode::Idle;
+        Fps = GestureIdleFps;
+    }
+    else if (Fps <= 0.f)
+    {
+        Fps = SmoothedGameFps > 0.f ? FMath::Max(GestureStreamFpsStep, FMath::RoundToFloat(SmoothedGameFps / GestureStreamFpsStep) * GestureStreamFpsStep) : 0.f;
+    }
+
+    if (SentGestureStreamMode.IsSet())
+    {
+        if (SentGestureStreamMode.GetValue() == Mode
+            && (FMath::IsNearlyEqual(Fps, SentGestureStreamFps) || Now - LastGestureStreamRateTime < GestureStreamRateHoldSeconds))
         {
-            continue;
+            return;
         }
 
-        FFusionHandSnapshot HandSnapshot;
-        FString ParsedState;
-        if (HandObject->TryGetStringField(TEXT("state"), ParsedState)
-            || HandObject->TryGetStringField(TEXT("hand_state"), ParsedState)
-            || HandObject->TryGetStringField(TEXT("gesture"), ParsedState))
+        GestureSocket->Send(FString::Printf(TEXT("{\"type\":\"fps\",\"fps\":%.1f}"), Fps));
+    }
+    else
+    {
+        TArray<TSharedPtr<FJsonValue>> FieldValues;
+        for (const FString& Field : GestureStreamFields)
         {
-            HandSnapshot.state = ParsedState;
+            FieldValues.Add(MakeShared<FJsonValueString>(Field));
         }
-        else
+
+        TSharedRef<FJsonObject> Subscription = MakeShared<FJsonObject>();
+        Subscription->SetStringField(TEXT("type"), TEXT("subscribe"));
+        // fps 0 leaves the rate to the tracker until the game frame rate is known.
+        Subscription->SetNumberField(TEXT("fps"), Fps);
+        if (FieldValues.Num() > 0)
         {
-            HandSnapshot.state.Reset();
+            Subscription->SetArrayField(TEXT("fields"), FieldValues);
         }
 
-        const TArray<TSharedPtr<FJsonValue>>* CoordinatesArray = nullptr;
-        if (HandObject->TryGetArrayField(TEXT("x_y_z"), CoordinatesArray) && CoordinatesArray)
+        const uint32 LandmarkMask = static_cast<uint32>(GetSubscribedLandmarkMask());
+        if (LandmarkMask != 0)
         {
-            HandSnapshot.x_y_z.Reset(CoordinatesArray->Num());
-            HandSnapshot.x_y_z.Reserve(CoordinatesArray->Num());
-            for (const TSharedPtr<FJsonValue>& CoordinateValue : *CoordinatesArray)
+            TArray<TSharedPtr<FJsonValue>> LandmarkValues;
+            for (int32 LandmarkId = 0; LandmarkId < 32; ++LandmarkId)
             {
-                if (!CoordinateValue.IsValid())
-                {
-                    continue;
-                }
-
-                double CoordinateNumber = 0.0;
-                if (CoordinateValue->TryGetNumber(CoordinateNumber))
-                {
-                    HandSnapshot.x_y_z.Add(static_cast<float>(CoordinateNumber));
-                    continue;
-                }
-
-                const TArray<TSharedPtr<FJsonValue>>* NestedArray = nullptr;
-                if (CoordinateValue->TryGetArray(NestedArray) && NestedArray)
+                if (LandmarkMask & (1u << LandmarkId))
                 {
-                    for (const TSharedPtr<FJsonValue>& NestedValue : *NestedArray)
-                    {
-                        double NestedNumber = 0.0;
-                        if (NestedValue.IsValid() && NestedValue->TryGetNumber(NestedNumber))
-                        {
-                            HandSnapshot.x_y_z.Add(static_cast<float>(NestedNumber));
-                        }
-                    }
+                    LandmarkValues.Add(MakeShared<FJsonValueNumber>(LandmarkId));
                 }
             }
+            Subscription->SetArrayField(TEXT("landmarks"), LandmarkValues);
         }
 
-        OutHands.Add(MoveTemp(HandSnapshot));
+        FString Payload;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Payload);
+        FJsonSerializer::Serialize(Subscription, Writer);
+        GestureSocket->Send(Payload);
     }
+
+    SentGestureStreamMode = Mode;
+    SentGestureStreamFps = Fps;
+    LastGestureStreamRateTime = Now;
+}
+
+void AFusionMode::HandleMapperStateChanged(EFusionState State)
+{
+    bMapperInDescription = State == EFusionState::Description;
+    UpdateGestureStreamRate();
 }
 
 void AFusionMode::RequestObjectDescription(const FString& ObjectId)
 {
-    if (DescribeEndpoint.IsEmpty())
-    {
-        LogOnScreen(ELogVerbosity::Warning, TEXT("DescribeEndpoint is empty; cannot request description."));
-        return;
-    }
+    EnqueueDescriptionRequest(ObjectId, EFusionRequestPriority::Description);
+}
+
+void AFusionMode::PrefetchObjectDescription(const FString& ObjectId)
+{
+    EnqueueDescriptionRequest(ObjectId, EFusionRequestPriority::Speculative);
+}
 
-    LogOnScreen(ELogVerbosity::Log, TEXT("Requesting description for %s"), *ObjectId);
+void AFusionMode::RequestObjectDescriptions(const TArray<FString>& ObjectIds)
+{
+    const bool bOverSocket = bMultiplexRequestsOverGestureSocket && SocketChannel.IsValid() && SocketChannel->IsAvailable();
 
-    const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-    Request->SetURL(DescribeEndpoint);
-    Request->SetVerb(TEXT("POST"));
-    Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-    if (!ApiToken.IsEmpty())
+    // Ids asked for together go out together right away; only prefetches wait for a batch window.
+    TArray<FString> Batch;
+    for (const FString& ObjectId : ObjectIds)
     {
-        Request->SetHeader(TEXT("Authorization"), ApiToken);
+        const bool bBatchable = !bOverSocket && CanBatchDescriptions() && !DescriptionBatchKeys.Contains(ObjectId)
+            && !(RequestScheduler.IsValid() && RequestScheduler->IsPending(FString::Printf(TEXT("describe:%s"), *ObjectId)));
+        if (bBatchable)
+        {
+            Batch.AddUnique(ObjectId);
+        }
+        else
+        {
+            EnqueueDescriptionRequest(ObjectId, EFusionRequestPriority::Description);
+        }
     }
 
-    TSharedRef<FJsonObject> Body = MakeShared<FJsonObject>();
-    Body->SetStringField(TEXT("object_id"), ObjectId);
-
-    FString Payload;
-    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Payload);
-    FJsonSerializer::Serialize(Body, Writer);
-    Request->SetContentAsString(Payload);
-
-    Request->OnProcessRequestComplete().BindUObject(this, &AFusionMode::OnDescriptionRequestComplete);
-    Request->ProcessRequest();
+    for (const FString& ObjectId : Batch)
+    {
+        PendingDescriptionBatch.Remove(ObjectId);
+    }
+    SendDescriptionBatches(Batch, EFusionRequestPriority::Description);
 }
 
-void AFusionMode::SendVoiceQuery(const FString& FilePath)
+TFuture<FFusionDescriptionResult> AFusionMode::RequestObjectDescriptionAsync(const FString& ObjectId, EFusionRequestPriority Priority,
+    const TSharedPtr<FFusionCancellationToken, ESPMode::ThreadSafe>& CancellationToken)
 {
-    if (VoiceQueryEndpoint.IsEmpty())
+    check(IsInGameThread());
+
+    const TSharedPtr<TPromise<FFusionDescriptionResult>> Promise = MakeShared<TPromise<FFusionDescriptionResult>>();
+    TFuture<FFusionDescriptionResult> Future = Promise->GetFuture();
+
+    if (CancellationToken.IsValid() && CancellationToken->IsCancelled())
     {
-        LogOnScreen(ELogVerbosity::Warning, TEXT("VoiceQueryEndpoint is empty; cannot send voice query."));
-        return;
+        FFusionDescriptionResult Result;
+        Result.ObjectId = ObjectId;
+        Result.Outcome = EFusionRequestOutcome::Cancelled;
+        Promise->SetValue(MoveTemp(Result));
+        return Future;
     }
 
-    TArray<uint8> FileData;
+    const uint64 WaiterId = NextDescriptionWaiterId++;
+    DescriptionWaiters.FindOrAdd(ObjectId).Add({ WaiterId, Promise });
+
+    if (CancellationToken.IsValid())
+    {
+        TWeakObjectPtr<AFusionMode> WeakThis = this;
+        CancellationToken->OnCancelled([WeakThis, ObjectId, WaiterId]()
+        {
+            if (AFusionMode* StrongThis = WeakThis.Get())
+            {
+                StrongThis->CancelDescriptionWaiter(ObjectId, WaiterId);
+            }
+        });
+    }
+
+    EnqueueDescriptionRequest(ObjectId, Priority);
+    return Future;
+}
+
+TFuture<FFusionVoiceAnswerResult> AFusionMode::SendVoiceQueryAsync(TArray<uint8>&& WavData, const TSharedPtr<FFusionCancellationToken, ESPMode::ThreadSafe>& CancellationToken)
+{
+    check(IsInGameThread());
+
+    const TSharedPtr<TPromise<FFusionVoiceAnswerResult>> Promise = MakeShared<TPromise<FFusionVoiceAnswerResult>>();
+    TFuture<FFusionVoiceAnswerResult> Future = Promise->GetFuture();
+
+    if (CancellationToken.IsValid() && CancellationToken->IsCancelled())
+    {
+        FFusionVoiceAnswerResult Result;
+        Result.Outcome = EFusionRequestOutcome::Cancelled;
+        Promise->SetValue(MoveTemp(Result));
+        return Future;
+    }
+
+    StartVoiceQuery(MoveTemp(WavData), Promise);
+
+    if (CancellationToken.IsValid())
+    {
+        TWeakObjectPtr<AFusionMode> WeakThis = this;
+        const uint32 Serial = VoiceQuerySerial;
+        CancellationToken->OnCancelled([WeakThis, Serial]()
+        {
+            AFusionMode* StrongThis = WeakThis.Get();
+            if (StrongThis && StrongThis->VoiceQuerySerial == Serial)
+            {
+                StrongThis->CancelRequest(TEXT("voice-query"));
+                StrongThis->FailVoiceAnswer(EFusionRequestOutcome::Cancelled);
+            }
+        });
+    }
+
+    return Future;
+}
+
+void AFusionMode::EnqueueDescriptionRequest(const FString& ObjectId, EFusionRequestPriority Priority)
+{
+    if (DescribeEndpoint.IsEmpty())
+    {
+        LogOnScreen(ELogVerbosity::Warning, TEXT("DescribeEndpoint is empty; cannot request description."));
+        FailDescriptionWaiters(ObjectId, EFusionRequestOutcome::Failed);
+        return;
+    }
+
+    // Over the socket there is no per-request connection cost to amortise, so nothing is batched.
+    if (SendDescriptionOverSocket(ObjectId, Priority))
+    {
+        return;
+    }
+
+    if (const FString* BatchKey = DescriptionBatchKeys.Find(ObjectId))
+    {
+        // Already part of a batch job; a committed request only needs that job to jump the queue.
+        if (RequestScheduler.IsValid())
+        {
+            RequestScheduler->Promote(*BatchKey, Priority);
+        }
+        return;
+    }
+
+    // The user is waiting on committed requests, so only prefetches sit out the batch window.
+    if (Priority != EFusionRequestPriority::Speculative || !CanBatchDescriptions())
+    {
+        PendingDescriptionBatch.Remove(ObjectId);
+        EnqueueSingleDescriptionRequest(ObjectId, Priority);
+        return;
+    }
+
+    PendingDescriptionBatch.AddUnique(ObjectId);
+
+    if (PendingDescriptionBatch.Num() >= MaxDescriptionBatchSize)
+    {
+        FlushDescriptionBatch();
+    }
+    else if (!GetWorldTimerManager().IsTimerActive(DescriptionBatchHandle))
+    {
+        GetWorldTimerManager().SetTimer(DescriptionBatchHandle, this, &AFusionMode::FlushDescriptionBatch, DescriptionBatchWindowSeconds, false);
+    }
+}
+
+void AFusionMode::FlushDescriptionBatch()
+{
+    GetWorldTimerManager().ClearTimer(DescriptionBatchHandle);
+
+    TArray<FString> Pending = MoveTemp(PendingDescriptionBatch);
+    PendingDescriptionBatch.Reset();
+
+    // Ids already being fetched one by one do not need to ride along.
+    Pending.RemoveAll([this](const FString& ObjectId)
+    {
+        return RequestScheduler.IsValid() && RequestScheduler->IsPending(FString::Printf(TEXT("describe:%s"), *ObjectId));
+    });
+
+    SendDescriptionBatches(Pending, EFusionRequestPriority::Speculative);
+}
+
+void AFusionMode::SendDescriptionBatches(const TArray<FString>& ObjectIds, EFusionRequestPriority Priority)
+{
+    if (ObjectIds.Num() == 1 || !bDescriptionBatchSupported)
+    {
+        for (const FString& ObjectId : ObjectIds)
+        {
+            EnqueueSingleDescriptionRequest(ObjectId, Priority);
+        }
+        return;
+    }
+
+    const int32 BatchSize = FMath::Max(1, MaxDescriptionBatchSize);
+    for (int32 Start = 0; Start < ObjectIds.Num(); Start += BatchSize)
+    {
+        const int32 Count = FMath::Min(BatchSize, ObjectIds.Num() - Start);
+        EnqueueDescriptionBatch(TArray<FString>(ObjectIds.GetData() + Start, Count), Priority);
+    }
+}
+
+bool AFusionMode::CanBatchDescriptions() const
+{
+    return bDescriptionBatchSupported && !DescribeBatchEndpoint.IsEmpty() && DescriptionBatchWindowSeconds > 0.f;
+}
+
+bool AFusionMode::CancelBatchedDescription(const FString& ObjectId)
+{
+    if (PendingDescriptionBatch.Remove(ObjectId) > 0)
+    {
+        if (PendingDescriptionBatch.Num() == 0)
+        {
+            GetWorldTimerManager().ClearTimer(DescriptionBatchHandle);
+        }
+        FailDescriptionWaiters(ObjectId, EFusionRequestOutcome::Cancelled);
+        return true;
+    }
+
+    FString BatchKey;
+    if (!DescriptionBatchKeys.RemoveAndCopyValue(ObjectId, BatchKey))
+    {
+        return false;
+    }
+    FailDescriptionWaiters(ObjectId, EFusionRequestOutcome::Cancelled);
+
+    // The rest of the batch still goes out; only a batch nobody wants any more is cancelled.
+    for (const TPair<FString, FString>& Entry : DescriptionBatchKeys)
+    {
+        if (Entry.Value == BatchKey)
+        {
+            return true;
+        }
+    }
+    if (RequestScheduler.IsValid())
+    {
+        RequestScheduler->Cancel(BatchKey);
+    }
+    return true;
+}
+
+void AFusionMode::EnqueueDescriptionBatch(const TArray<FString>& ObjectIds, EFusionRequestPriority Priority)
+{
+    if (!RequestScheduler.IsValid())
+    {
+        LogOnScreen(ELogVerbosity::Warning, TEXT("Request scheduler is not running; dropping %d description requests"), ObjectIds.Num());
+        for (const FString& ObjectId : ObjectIds)
+        {
+            FailDescriptionWaiters(ObjectId, EFusionRequestOutcome::Failed);
+        }
+        return;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> IdValues;
+    IdValues.Reserve(ObjectIds.Num());
+    for (const FString& ObjectId : ObjectIds)
+    {
+        IdValues.Add(MakeShared<FJsonValueString>(ObjectId));
+    }
+
+    TSharedRef<FJsonObject> Body = MakeShared<FJsonObject>();
+    Body->SetArrayField(TEXT("object_ids"), IdValues);
+
+    FString Payload;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Payload);
+    FJsonSerializer::Serialize(Body, Writer);
+
+    const FString BatchKey = FString::Printf(TEXT("describe-batch:%d"), NextDescriptionBatchId++);
+
+    FFusionRequestJob Job;
+    Job.Key = BatchKey;
+    Job.Url = DescribeBatchEndpoint;
+    Job.ReplicaUrls = DescribeBatchEndpointReplicas;
+    Job.HedgePercentile = HedgePercentile;
+    Job.Priority = Priority;
+    Job.DeadlineSeconds = DescriptionDeadlineSeconds;
+    Job.MaxRetries = DescriptionMaxRetries;
+    Job.RetryBaseDelaySeconds = DescriptionRetryBaseDelaySeconds;
+    Job.ConfigureRequest = [Payload = MoveTemp(Payload), ApiToken = ApiToken](const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request)
+    {
+        Request->SetVerb(TEXT("POST"));
+        Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+        if (!ApiToken.IsEmpty())
+        {
+            Request->SetHeader(TEXT("Authorization"), ApiToken);
+        }
+        Request->SetContentAsString(Payload);
+    };
+
+    TWeakObjectPtr<AFusionMode> WeakThis = this;
+    Job.OnComplete = [WeakThis, BatchKey, ObjectIds, Priority](FHttpResponsePtr Response, EFusionRequestOutcome Outcome)
+    {
+        if (AFusionMode* StrongThis = WeakThis.Get())
+        {
+            StrongThis->OnDescriptionBatchComplete(BatchKey, ObjectIds, Priority, Response, Outcome);
+        }
+    };
+
+    for (const FString& ObjectId : ObjectIds)
+    {
+        DescriptionBatchKeys.Add(ObjectId, BatchKey);
+    }
+    RequestScheduler->Enqueue(MoveTemp(Job));
+    LogOnScreen(ELogVerbosity::Log, TEXT("Requesting descriptions for %d objects in one batch"), ObjectIds.Num());
+}
+
+void AFusionMode::EnqueueSingleDescriptionRequest(const FString& ObjectId, EFusionRequestPriority Priority)
+{
+    if (!RequestScheduler.IsValid())
+    {
+        LogOnScreen(ELogVerbosity::Warning, TEXT("Request scheduler is not running; dropping description request for %s"), *ObjectId);
+        FailDescriptionWaiters(ObjectId, EFusionRequestOutcome::Failed);
+        return;
+    }
+
+    TSharedRef<FJsonObject> Body = MakeShared<FJsonObject>();
+    Body->SetStringField(TEXT("object_id"), ObjectId);
+
+    FString Payload;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Payload);
+    FJsonSerializer::Serialize(Body, Writer);
+
+    FFusionRequestJob Job;
+    Job.Key = FString::Printf(TEXT("describe:%s"), *ObjectId);
+    Job.Url = DescribeEndpoint;
+    Job.ReplicaUrls = DescribeEndpointReplicas;
+    Job.HedgePercentile = HedgePercentile;
+    Job.Priority = Priority;
+    Job.DeadlineSeconds = DescriptionDeadlineSeconds;
+    Job.MaxRetries = DescriptionMaxRetries;
+    Job.RetryBaseDelaySeconds = DescriptionRetryBaseDelaySeconds;
+    Job.ConfigureRequest = [Payload = MoveTemp(Payload), ApiToken = ApiToken](const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request)
+    {
+        Request->SetVerb(TEXT("POST"));
+        Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+        if (!ApiToken.IsEmpty())
+        {
+            Request->SetHeader(TEXT("Authorization"), ApiToken);
+        }
+        Request->SetContentAsString(Payload);
+    };
+
+    TWeakObjectPtr<AFusionMode> WeakThis = this;
+    Job.OnComplete = [WeakThis, ObjectId](FHttpResponsePtr Response, EFusionRequestOutcome Outcome)
+    {
+        if (AFusionMode* StrongThis = WeakThis.Get())
+        {
+            StrongThis->OnDescriptionRequestComplete(ObjectId, Response, Outcome);
+        }
+    };
+
+    if (RequestScheduler->Enqueue(MoveTemp(Job)))
+    {
+        LogOnScreen(ELogVerbosity::Log, TEXT("Requesting description for %s"), *ObjectId);
+    }
+}
+
+bool AFusionMode::SendDescriptionOverSocket(const FString& ObjectId, EFusionRequestPriority Priority)
+{
+    if (!bMultiplexRequestsOverGestureSocket || !SocketChannel.IsValid() || !SocketChannel->IsAvailable())
+    {
+        return false;
+    }
+
+    const FString Key = FString::Printf(TEXT("describe:%s"), *ObjectId);
+    if (SocketChannel->IsPending(Key) || (RequestScheduler.IsValid() && RequestScheduler->IsPending(Key)))
+    {
+        return true;
+    }
+
+    const TSharedRef<FJsonObject> Message = MakeShared<FJsonObject>();
+    Message->SetStringField(TEXT("type"), TEXT("describe"));
+    Message->SetStringField(TEXT("object_id"), ObjectId);
+    Message->SetBoolField(TEXT("speculative"), Priority == EFusionRequestPriority::Speculative);
+
+    TWeakObjectPtr<AFusionMode> WeakThis = this;
+    FFusionSocketChannel::FRequest Request;
+    Request.Key = Key;
+    Request.Priority = Priority;
+    Request.DeadlineSeconds = DescriptionDeadlineSeconds;
+    Request.OnReply = [WeakThis, ObjectId](const FJsonObject& Reply)
+    {
+        if (AFusionMode* StrongThis = WeakThis.Get())
+        {
+            FusionResponse::FDescription Result;
+            FusionResponse::ReadDescription(Reply, Result);
+            StrongThis->BroadcastDescriptionToUI(Result.ObjectId.IsEmpty() ? ObjectId : Result.ObjectId, Result.Description, Result.TtsUrl);
+        }
+        return true;
+    };
+    Request.OnFailed = [WeakThis, ObjectId, Priority](EFusionRequestOutcome Outcome)
+    {
+        AFusionMode* StrongThis = WeakThis.Get();
+        if (!StrongThis)
+        {
+            return;
+        }
+
+        // A request that used up its deadline is not given a second one over HTTP.
+        if (Outcome == EFusionRequestOutcome::Cancelled || Outcome == EFusionRequestOutcome::Expired)
+        {
+            if (Outcome == EFusionRequestOutcome::Expired && !StrongThis->ServeCachedDescription(ObjectId))
+            {
+                StrongThis->LogOnScreen(ELogVerbosity::Error, TEXT("Description request timed out"));
+            }
+            StrongThis->FailDescriptionWaiters(ObjectId, Outcome);
+            return;
+        }
+
+        StrongThis->EnqueueSingleDescriptionRequest(ObjectId, Priority);
+    };
+
+    if (!SocketChannel->Send(MoveTemp(Request), Message))
+    {
+        return false;
+    }
+
+    LogOnScreen(ELogVerbosity::Log, TEXT("Requesting description for %s over the gesture socket"), *ObjectId);
+    return true;
+}
+
+void AFusionMode::SendVoiceQuery(const FString& FilePath)
+{
+    if (VoiceQueryEndpoint.IsEmpty())
+    {
+        LogOnScreen(ELogVerbosity::Warning, TEXT("VoiceQueryEndpoint is empty; cannot send voice query."));
+        return;
+    }
+
+    TArray<uint8> FileData;
     if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
     {
         LogOnScreen(ELogVerbosity::Error, TEXT("Failed to load wav file: %s"), *FilePath);
         return;
     }
 
-    LogOnScreen(ELogVerbosity::Log, TEXT("Uploading voice query (%d bytes)"), FileData.Num());
+    SendVoiceQueryData(MoveTemp(FileData));
+}
+
+void AFusionMode::SendVoiceQueryData(TArray<uint8>&& WavData)
+{
+    StartVoiceQuery(MoveTemp(WavData), nullptr);
+}
+
+void AFusionMode::StartVoiceQuery(TArray<uint8>&& WavData, TSharedPtr<TPromise<FFusionVoiceAnswerResult>> Promise)
+{
+    // Only one voice query runs at a time; the future of the one being replaced resolves as cancelled.
+    FailVoiceAnswer(EFusionRequestOutcome::Cancelled);
+    PendingVoiceAnswer = MoveTemp(Promise);
+    ++VoiceQuerySerial;
 
-    const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-    Request->SetURL(VoiceQueryEndpoint);
-    Request->SetVerb(TEXT("POST"));
-    Request->SetHeader(TEXT("Content-Type"), TEXT("audio/wav"));
-    if (!ApiToken.IsEmpty())
+    if (VoiceQueryEndpoint.IsEmpty())
     {
-        Request->SetHeader(TEXT("Authorization"), ApiToken);
+        LogOnScreen(ELogVerbosity::Warning, TEXT("VoiceQueryEndpoint is empty; cannot send voice query."));
+        FailVoiceAnswer(EFusionRequestOutcome::Failed);
+        return;
     }
 
-    Request->SetContent(FileData);
-    Request->OnProcessRequestComplete().BindUObject(this, &AFusionMode::OnVoiceQueryComplete);
-    Request->ProcessRequest();
+    if (bMultiplexRequestsOverGestureSocket && SocketChannel.IsValid() && SocketChannel->IsAvailable())
+    {
+        const TSharedRef<TArray<uint8>> SharedWavData = MakeShared<TArray<uint8>>(MoveTemp(WavData));
+        if (SendVoiceQueryOverSocket(SharedWavData))
+        {
+            return;
+        }
+        WavData = MoveTemp(*SharedWavData);
+    }
+
+    SendVoiceQueryOverHttp(MoveTemp(WavData));
 }
 
-void AFusionMode::OnDescriptionRequestComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void AFusionMode::SendVoiceQueryOverHttp(TArray<uint8>&& WavData)
 {
-    if (!bWasSuccessful || !Response.IsValid())
+    if (!RequestScheduler.IsValid())
     {
-        LogOnScreen(ELogVerbosity::Error, TEXT("Description request failed"));
+        LogOnScreen(ELogVerbosity::Warning, TEXT("Request scheduler is not running; dropping voice query."));
+        FailVoiceAnswer(EFusionRequestOutcome::Failed);
         return;
     }
 
-    const FString ResponseStr = Response->GetContentAsString();
-    LogOnScreen(ELogVerbosity::Verbose, TEXT("Description response: %s"), *ResponseStr);
+    if (SocketChannel.IsValid())
+    {
+        SocketChannel->Cancel(TEXT("voice-query"));
+    }
 
-    TSharedPtr<FJsonObject> JsonPayload;
-    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseStr);
-    if (FJsonSerializer::Deserialize(Reader, JsonPayload) && JsonPayload.IsValid())
+    LogOnScreen(ELogVerbosity::Log, TEXT("Uploading voice query (%d bytes)"), WavData.Num());
+
+    TSharedPtr<FFusionVoiceAnswerStream, ESPMode::ThreadSafe> Stream;
+    if (bStreamVoiceAnswers)
     {
-        FString ObjectId;
-        JsonPayload->TryGetStringField(TEXT("object_id"), ObjectId);
+        Stream = MakeShared<FFusionVoiceAnswerStream, ESPMode::ThreadSafe>();
+    }
+    ActiveVoiceStream = Stream;
+    StreamedQuestion.Reset();
+    StreamedAnswer.Reset();
+
+    TWeakObjectPtr<AFusionMode> WeakThis = this;
+
+    // A newer question always replaces one that is still waiting for its answer.
+    FFusionRequestJob Job;
+    Job.Key = TEXT("voice-query");
+    Job.Url = VoiceQueryEndpoint;
+    Job.ReplicaUrls = VoiceQueryEndpointReplicas;
+    Job.Priority = EFusionRequestPriority::Voice;
+    Job.DeadlineSeconds = VoiceQueryDeadlineSeconds;
+    Job.bSupersedeExisting = true;
+    Job.ConfigureRequest = [WavData = MoveTemp(WavData), ApiToken = ApiToken, Stream, WeakThis](const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request)
+    {
+        Request->SetVerb(TEXT("POST"));
+        Request->SetHeader(TEXT("Content-Type"), TEXT("audio/wav"));
+        if (!ApiToken.IsEmpty())
+        {
+            Request->SetHeader(TEXT("Authorization"), ApiToken);
+        }
+        Request->SetContent(WavData);
 
-        FString Description;
-        JsonPayload->TryGetStringField(TEXT("description"), Description);
+        if (Stream.IsValid())
+        {
+            Request->SetHeader(TEXT("Accept"), TEXT("text/event-stream, application/json"));
 
-        FString TtsUrl;
-        JsonPayload->TryGetStringField(TEXT("tts_url"), TtsUrl);
+            // Runs on the HTTP thread: parse there, then hop to the game thread only when an event completed.
+            Request->SetResponseBodyReceiveStreamDelegateV2(FHttpRequestStreamDelegateV2::CreateLambda([Stream, WeakThis](void* Ptr, int64& Length)
+            {
+                if (Stream->AppendBytes(static_cast<const uint8*>(Ptr), Length))
+                {
+                    AsyncTask(ENamedThreads::GameThread, [Stream, WeakThis]()
+                    {
+                        if (AFusionMode* StrongThis = WeakThis.Get())
+                        {
+                            StrongThis->DrainVoiceAnswerStream(Stream);
+                        }
+                    });
+                }
+            }));
+        }
+    };
+
+    Job.OnComplete = [WeakThis, Stream](FHttpResponsePtr Response, EFusionRequestOutcome Outcome)
+    {
+        if (AFusionMode* StrongThis = WeakThis.Get())
+        {
+            StrongThis->OnVoiceQueryComplete(Response, Outcome, Stream);
+        }
+    };
+
+    RequestScheduler->Enqueue(MoveTemp(Job));
+}
+
+bool AFusionMode::SendVoiceQueryOverSocket(const TSharedRef<TArray<uint8>>& WavData)
+{
+    // Replaces an HTTP query still waiting for its answer, the same way a newer HTTP query would.
+    if (RequestScheduler.IsValid())
+    {
+        RequestScheduler->Cancel(TEXT("voice-query"));
+    }
+    ActiveVoiceStream.Reset();
+    StreamedQuestion.Reset();
+    StreamedAnswer.Reset();
+
+    const TSharedRef<FJsonObject> Header = MakeShared<FJsonObject>();
+    Header->SetStringField(TEXT("type"), TEXT("voice_query"));
+    Header->SetStringField(TEXT("format"), TEXT("wav"));
+    Header->SetBoolField(TEXT("stream"), bStreamVoiceAnswers);
+
+    TWeakObjectPtr<AFusionMode> WeakThis = this;
+    FFusionSocketChannel::FRequest Request;
+    Request.Key = TEXT("voice-query");
+    Request.Priority = EFusionRequestPriority::Voice;
+    Request.DeadlineSeconds = VoiceQueryDeadlineSeconds;
+    Request.OnReply = [WeakThis](const FJsonObject& Reply)
+    {
+        AFusionMode* StrongThis = WeakThis.Get();
+        return !StrongThis || StrongThis->HandleSocketVoiceReply(Reply);
+    };
+    Request.OnFailed = [WeakThis, WavData](EFusionRequestOutcome Outcome)
+    {
+        AFusionMode* StrongThis = WeakThis.Get();
+        if (!StrongThis || Outcome == EFusionRequestOutcome::Cancelled)
+        {
+            return;
+        }
+
+        if (Outcome == EFusionRequestOutcome::Expired || StrongThis->VoiceQueryEndpoint.IsEmpty())
+        {
+            StrongThis->LogOnScreen(ELogVerbosity::Error, Outcome == EFusionRequestOutcome::Expired ? TEXT("Voice query timed out") : TEXT("Voice query request failed"));
+            StrongThis->FailVoiceAnswer(Outcome);
+            return;
+        }
+
+        StrongThis->LogOnScreen(ELogVerbosity::Warning, TEXT("Voice query over the gesture socket failed; retrying over HTTP"));
+        StrongThis->SendVoiceQueryOverHttp(MoveTemp(*WavData));
+    };
+
+    if (!SocketChannel->SendBinary(MoveTemp(Request), Header, *WavData))
+    {
+        return false;
+    }
+
+    LogOnScreen(ELogVerbosity::Log, TEXT("Uploading voice query (%d bytes) over the gesture socket"), WavData->Num());
+    return true;
+}
+
+bool AFusionMode::HandleSocketVoiceReply(const FJsonObject& Reply)
+{
+    FString Type;
+    Reply.TryGetStringField(TEXT("type"), Type);
+
+    FString Text;
+    if (Type == TEXT("voice_question"))
+    {
+        Reply.TryGetStringField(TEXT("user_question"), StreamedQuestion);
+        OnVoiceAnswerChunkReceived.Broadcast(StreamedQuestion, FString());
+        return false;
+    }
+    if (Type == TEXT("voice_token"))
+    {
+        if (Reply.TryGetStringField(TEXT("token"), Text))
+        {
+            StreamedAnswer.Append(Text);
+            OnVoiceAnswerChunkReceived.Broadcast(StreamedQuestion, Text);
+        }
+        return false;
+    }
+
+    // The final answer carries the authoritative text; streamed pieces only fill in what it leaves out.
+    FusionResponse::FVoiceAnswer Result;
+    Result.Question = StreamedQuestion;
+    Result.Answer = StreamedAnswer;
+    Reply.TryGetStringField(TEXT("user_question"), Result.Question);
+    Reply.TryGetStringField(TEXT("llm_result"), Result.Answer);
+
+    LogOnScreen(ELogVerbosity::Log, TEXT("Voice answer received over the gesture socket (%d chars)"), Result.Answer.Len());
+    BroadcastVoiceAnswerToUI(Result.Question, Result.Answer);
+
+    FFusionVoiceAnswerResult Answer;
+    Answer.Outcome = EFusionRequestOutcome::Succeeded;
+    Answer.Question = Result.Question;
+    Answer.Answer = Result.Answer;
+    ResolveVoiceAnswer(Answer);
+    return true;
+}
+
+bool AFusionMode::HandleSocketChannelMessage(const FJsonObject& Message)
+{
+    if (SocketChannel.IsValid() && SocketChannel->HandleMessage(Message))
+    {
+        return true;
+    }
+
+    // Answers the server pushes without being asked, e.g. for an object the camera pipeline recognised itself.
+    FString Type;
+    if (!Message.TryGetStringField(TEXT("type"), Type))
+    {
+        return false;
+    }
+
+    if (Type == TEXT("pong"))
+    {
+        HandleGesturePong(Message);
+        return true;
+    }
+
+    if (Type == TEXT("description"))
+    {
+        FusionResponse::FDescription Result;
+        FusionResponse::ReadDescription(Message, Result);
+        if (!Result.ObjectId.IsEmpty())
+        {
+            BroadcastDescriptionToUI(Result.ObjectId, Result.Description, Result.TtsUrl);
+        }
+        return true;
+    }
+
+    if (Type == TEXT("voice_answer"))
+    {
+        FusionResponse::FVoiceAnswer Result;
+        Message.TryGetStringField(TEXT("user_question"), Result.Question);
+        Message.TryGetStringField(TEXT("llm_result"), Result.Answer);
+        BroadcastVoiceAnswerToUI(Result.Question, Result.Answer);
+        return true;
+    }
+
+    return false;
+}
+
+bool AFusionMode::CancelRequest(const FString& Key)
+{
+    const bool bCancelledOnSocket = SocketChannel.IsValid() && SocketChannel->Cancel(Key);
+    const bool bCancelledOnHttp = RequestScheduler.IsValid() && RequestScheduler->Cancel(Key);
+    const bool bCancelledInBatch = Key.StartsWith(TEXT("describe:")) && CancelBatchedDescription(Key.RightChop(9));
+    const bool bCancelled = bCancelledOnSocket || bCancelledOnHttp || bCancelledInBatch;
+
+    // Superseded voice jobs also report Cancelled, so the voice future is only resolved for explicit cancellation.
+    if (bCancelled && Key == TEXT("voice-query"))
+    {
+        FailVoiceAnswer(EFusionRequestOutcome::Cancelled);
+    }
+    return bCancelled;
+}
+
+FFusionRequestSchedulerStats AFusionMode::GetRequestSchedulerStats() const
+{
+    return RequestScheduler.IsValid() ? RequestScheduler->GetStats() : FFusionRequestSchedulerStats();
+}
+
+bool AFusionMode::DumpRequestTimings(const FString& FilePath) const
+{
+    return FFusionRequestTelemetry::Get().DumpCsv(FilePath);
+}
+
+int32 AFusionMode::RegisterLandmarkSubscription(const TArray<int32>& LandmarkIds)
+{
+    const int32 PreviousMask = GetSubscribedLandmarkMask();
+
+    uint32 Mask = 0;
+    for (const int32 LandmarkId : LandmarkIds)
+    {
+        if (LandmarkId >= 0 && LandmarkId < 32)
+        {
+            Mask |= 1u << LandmarkId;
+        }
+    }
+
+    const int32 Handle = NextLandmarkSubscriptionHandle++;
+    LandmarkSubscriptions.Add(Handle, static_cast<int32>(Mask));
+    if (GetSubscribedLandmarkMask() != PreviousMask)
+    {
+        SendGestureSubscription();
+    }
+    return Handle;
+}
+
+void AFusionMode::UnregisterLandmarkSubscription(int32 Handle)
+{
+    const int32 PreviousMask = GetSubscribedLandmarkMask();
+    if (LandmarkSubscriptions.Remove(Handle) > 0 && GetSubscribedLandmarkMask() != PreviousMask)
+    {
+        SendGestureSubscription();
+    }
+}
+
+int32 AFusionMode::GetSubscribedLandmarkMask() const
+{
+    uint32 Mask = 0;
+    for (const TPair<int32, int32>& Subscription : LandmarkSubscriptions)
+    {
+        // A consumer that registered no valid id wants every landmark, which no mask can express.
+        if (Subscription.Value == 0)
+        {
+            return 0;
+        }
+        Mask |= static_cast<uint32>(Subscription.Value);
+    }
+    return static_cast<int32>(Mask);
+}
+
+bool AFusionMode::GetHandLandmarkLocation(const FFusionHandSnapshot& Hand, int32 LandmarkId, FVector& OutLocation)
+{
+    const int32 BaseIndex = Hand.GetLandmarkOffset(LandmarkId);
+    if (BaseIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const float Z = Hand.x_y_z.IsValidIndex(BaseIndex + 2) ? Hand.x_y_z[BaseIndex + 2] : 0.f;
+    OutLocation = FVector(Hand.x_y_z[BaseIndex], Hand.x_y_z[BaseIndex + 1], Z);
+    return true;
+}
+
+bool AFusionMode::GetTrackerClockEstimate(double& OutOffsetSeconds, double& OutRoundTripSeconds) const
+{
+    OutOffsetSeconds = TrackerClock.GetOffset();
+    OutRoundTripSeconds = TrackerClock.GetRoundTrip();
+    return TrackerClock.HasEstimate();
+}
+
+TArray<FFusionGestureStreamStats> AFusionMode::GetGestureStreamStats() const
+{
+    const double Now = FPlatformTime::Seconds();
 
-        BroadcastDescriptionToUI(ObjectId, Description, TtsUrl);
+    TArray<FFusionGestureStreamStats> Streams;
+    Streams.Reserve(GestureSequenceTrackers.Num());
+    for (const TPair<FString, TSharedPtr<FFusionGestureSequenceTracker>>& Pair : GestureSequenceTrackers)
+    {
+        FFusionGestureStreamStats& Stream = Streams.AddDefaulted_GetRef();
+        Stream.Source = Pair.Key;
+        Pair.Value->GetStats(Now, Stream);
     }
+    return Streams;
 }
 
-void AFusionMode::OnVoiceQueryComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void AFusionMode::UpdateGestureStreamOverlay()
 {
-    if (!bWasSuccessful || !Response.IsValid())
+    const double Now = FPlatformTime::Seconds();
+    if (!FFusionGestureSequenceTracker::IsDebugOverlayEnabled() || !FFusionDebugOverlay::ShouldUpdate(Now, LastGestureOverlayUpdate))
     {
-        LogOnScreen(ELogVerbosity::Error, TEXT("Voice query request failed"));
         return;
     }
 
-    const FString ResponseStr = Response->GetContentAsString();
-    LogOnScreen(ELogVerbosity::Verbose, TEXT("Voice response: %s"), *ResponseStr);
+    FFusionGestureSequenceTracker::ShowDebugOverlay(GetGestureStreamStats(), GetGestureTransportStats());
+}
 
-    TSharedPtr<FJsonObject> JsonPayload;
-    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseStr);
-    if (FJsonSerializer::Deserialize(Reader, JsonPayload) && JsonPayload.IsValid())
+FFusionGestureTransportStats AFusionMode::GetGestureTransportStats() const
+{
+    return GestureSource.IsValid() ? GestureSource->GetStats() : FFusionGestureTransportStats();
+}
+
+void AFusionMode::TickRequestScheduler()
+{
+    if (RequestScheduler.IsValid())
+    {
+        RequestScheduler->SetMaxConcurrentPerEndpoint(MaxConcurrentRequestsPerEndpoint);
+        RequestScheduler->SetCircuitBreakerSettings({ CircuitBreakerFailureThreshold, CircuitBreakerOpenSeconds });
+        RequestScheduler->SetHedgingSettings({ HedgeMinDelaySeconds, HedgeFallbackDelaySeconds });
+        RequestScheduler->Tick();
+    }
+
+    if (SocketChannel.IsValid())
+    {
+        SocketChannel->Tick();
+    }
+
+    FFusionRequestTelemetry::Get().UpdateDebugOverlay();
+    UpdateGestureStreamOverlay();
+}
+
+void AFusionMode::HandleCircuitStateChanged(const FString& Endpoint, EFusionCircuitState State)
+{
+    switch (State)
+    {
+    case EFusionCircuitState::Open:
+        LogOnScreen(ELogVerbosity::Error, TEXT("AI backend %s is failing; answering from cache for %.0fs"), *Endpoint, CircuitBreakerOpenSeconds);
+        break;
+    case EFusionCircuitState::HalfOpen:
+        LogOnScreen(ELogVerbosity::Warning, TEXT("Probing AI backend %s"), *Endpoint);
+        break;
+    case EFusionCircuitState::Closed:
+        LogOnScreen(ELogVerbosity::Log, TEXT("AI backend %s recovered"), *Endpoint);
+        break;
+    }
+
+    OnBackendHealthChanged.Broadcast(Endpoint, State);
+}
+
+bool AFusionMode::ServeCachedDescription(const FString& ObjectId)
+{
+    const FCachedDescription* Cached = DescriptionCache.Find(ObjectId);
+    if (!Cached)
+    {
+        return false;
+    }
+
+    FFusionDescriptionResult Result;
+    Result.Outcome = EFusionRequestOutcome::Succeeded;
+    Result.ObjectId = ObjectId;
+    Result.Description = Cached->Description;
+    Result.TtsUrl = Cached->TtsUrl;
+    Result.bFromCache = true;
+
+    ResolveDescriptionWaiters(Result);
+    BroadcastDescriptionToUI(ObjectId, Result.Description, Result.TtsUrl);
+    return true;
+}
+
+void AFusionMode::CacheDescription(const FString& ObjectId, const FString& Description, const FString& TtsUrl)
+{
+    if (ObjectId.IsEmpty() || MaxCachedDescriptions <= 0)
+    {
+        return;
+    }
+
+    FCachedDescription& Entry = DescriptionCache.FindOrAdd(ObjectId);
+    Entry.Description = Description;
+    Entry.TtsUrl = TtsUrl;
+    Entry.LastUsed = FPlatformTime::Seconds();
+
+    while (DescriptionCache.Num() > MaxCachedDescriptions)
+    {
+        FString Oldest;
+        double OldestTime = TNumericLimits<double>::Max();
+        for (const TPair<FString, FCachedDescription>& Pair : DescriptionCache)
+        {
+            if (Pair.Value.LastUsed < OldestTime)
+            {
+                OldestTime = Pair.Value.LastUsed;
+                Oldest = Pair.Key;
+            }
+        }
+        DescriptionCache.Remove(Oldest);
+    }
+}
+
+void AFusionMode::OnDescriptionRequestComplete(const FString& ObjectId, FHttpResponsePtr Response, EFusionRequestOutcome Outcome)
+{
+    if (Outcome == EFusionRequestOutcome::Cancelled)
+    {
+        FailDescriptionWaiters(ObjectId, Outcome);
+        return;
+    }
+
+    if (Outcome != EFusionRequestOutcome::Succeeded || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+    {
+        if (ServeCachedDescription(ObjectId))
+        {
+            LogOnScreen(ELogVerbosity::Warning, TEXT("Description backend unavailable; showing cached description for %s"), *ObjectId);
+            return;
+        }
+
+        LogOnScreen(ELogVerbosity::Error, Outcome == EFusionRequestOutcome::Expired ? TEXT("Description request timed out")
+            : Outcome == EFusionRequestOutcome::Rejected ? TEXT("Description backend unavailable")
+            : TEXT("Description request failed"));
+        FailDescriptionWaiters(ObjectId, Outcome == EFusionRequestOutcome::Succeeded ? EFusionRequestOutcome::Failed : Outcome);
+        return;
+    }
+
+    TWeakObjectPtr<AFusionMode> WeakThis = this;
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, ObjectId, Response]()
+    {
+        FusionResponse::FDescription Result;
+        const bool bParsed = FusionResponse::DecodeDescription(Response->GetContent(), Result);
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, ObjectId, bParsed, Result = MoveTemp(Result)]()
+        {
+            AFusionMode* StrongThis = WeakThis.Get();
+            if (!StrongThis)
+            {
+                return;
+            }
+
+            if (!bParsed)
+            {
+                if (!StrongThis->ServeCachedDescription(ObjectId))
+                {
+                    StrongThis->LogOnScreen(ELogVerbosity::Error, TEXT("Description response for %s could not be parsed"), *ObjectId);
+                    StrongThis->FailDescriptionWaiters(ObjectId, EFusionRequestOutcome::Failed);
+                }
+                return;
+            }
+
+            StrongThis->BroadcastDescriptionToUI(Result.ObjectId.IsEmpty() ? ObjectId : Result.ObjectId, Result.Description, Result.TtsUrl);
+        });
+    });
+}
+
+void AFusionMode::OnDescriptionBatchComplete(const FString& BatchKey, TArray<FString> ObjectIds, EFusionRequestPriority Priority, FHttpResponsePtr Response, EFusionRequestOutcome Outcome)
+{
+    // Ids cancelled while the batch was out have already been answered.
+    ObjectIds.RemoveAll([this, &BatchKey](const FString& ObjectId)
+    {
+        const FString* Key = DescriptionBatchKeys.Find(ObjectId);
+        return !Key || *Key != BatchKey;
+    });
+    for (const FString& ObjectId : ObjectIds)
     {
-        FString Q;
-        JsonPayload->TryGetStringField(TEXT("user_question"), Q);
+        DescriptionBatchKeys.Remove(ObjectId);
+    }
+
+    if (Outcome == EFusionRequestOutcome::Cancelled)
+    {
+        for (const FString& ObjectId : ObjectIds)
+        {
+            FailDescriptionWaiters(ObjectId, Outcome);
+        }
+        return;
+    }
 
-        FString A;
-        JsonPayload->TryGetStringField(TEXT("llm_result"), A);
+    const int32 StatusCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+    const bool bEndpointMissing = StatusCode == EHttpResponseCodes::NotFound
+        || StatusCode == EHttpResponseCodes::BadMethod
+        || StatusCode == EHttpResponseCodes::NotSupported;
+    if (bEndpointMissing)
+    {
+        // Single-request backend: remember that and replay the batch the old way.
+        LogOnScreen(ELogVerbosity::Warning, TEXT("Batch description endpoint unavailable (status %d); falling back to single requests."), StatusCode);
+        bDescriptionBatchSupported = false;
+        for (const FString& ObjectId : ObjectIds)
+        {
+            EnqueueSingleDescriptionRequest(ObjectId, Priority);
+        }
+        return;
+    }
 
-        LogOnScreen(ELogVerbosity::Log, TEXT("Q: %s / A : %s"), *Q, *A);
- 
-        BroadcastVoiceAnswerToUI(Q, A);
+    if (Outcome != EFusionRequestOutcome::Succeeded || !EHttpResponseCodes::IsOk(StatusCode))
+    {
+        int32 NumServedFromCache = 0;
+        const EFusionRequestOutcome FailedOutcome = Outcome == EFusionRequestOutcome::Succeeded ? EFusionRequestOutcome::Failed : Outcome;
+        for (const FString& ObjectId : ObjectIds)
+        {
+            if (ServeCachedDescription(ObjectId))
+            {
+                ++NumServedFromCache;
+            }
+            else
+            {
+                FailDescriptionWaiters(ObjectId, FailedOutcome);
+            }
+        }
+        LogOnScreen(ELogVerbosity::Error, TEXT("Batch description request failed (status %d); %d of %d served from cache"), StatusCode, NumServedFromCache, ObjectIds.Num());
+        return;
+    }
+
+    TWeakObjectPtr<AFusionMode> WeakThis = this;
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, ObjectIds = MoveTemp(ObjectIds), Priority, Response]() mutable
+    {
+        TArray<FusionResponse::FDescription> Results;
+        FusionResponse::DecodeDescriptionBatch(Response->GetContent(), Results);
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, ObjectIds = MoveTemp(ObjectIds), Priority, Results = MoveTemp(Results)]()
+        {
+            AFusionMode* StrongThis = WeakThis.Get();
+            if (!StrongThis)
+            {
+                return;
+            }
+
+            TSet<FString> Missing(ObjectIds);
+            for (const FusionResponse::FDescription& Result : Results)
+            {
+                if (Missing.Remove(Result.ObjectId) > 0)
+                {
+                    StrongThis->BroadcastDescriptionToUI(Result.ObjectId, Result.Description, Result.TtsUrl);
+                }
+            }
+
+            // Objects the batch answer skipped (or an unreadable answer) get one more chance through the single endpoint.
+            for (const FString& ObjectId : Missing)
+            {
+                StrongThis->EnqueueSingleDescriptionRequest(ObjectId, Priority);
+            }
+        });
+    });
+}
+
+void AFusionMode::OnVoiceQueryComplete(FHttpResponsePtr Response, EFusionRequestOutcome Outcome, TSharedPtr<FFusionVoiceAnswerStream, ESPMode::ThreadSafe> Stream)
+{
+    if (Stream.IsValid())
+    {
+        if (Stream != ActiveVoiceStream)
+        {
+            return;
+        }
+
+        Stream->Finish();
+        DrainVoiceAnswerStream(Stream);
+        ActiveVoiceStream.Reset();
+    }
+
+    // Cancellation resolves the voice future where it is requested; see CancelRequest and StartVoiceQuery.
+    if (Outcome == EFusionRequestOutcome::Cancelled)
+    {
+        return;
+    }
+
+    if (Outcome != EFusionRequestOutcome::Succeeded || !Response.IsValid())
+    {
+        LogOnScreen(ELogVerbosity::Error, Outcome == EFusionRequestOutcome::Expired ? TEXT("Voice query timed out")
+            : Outcome == EFusionRequestOutcome::Rejected ? TEXT("Voice backend unavailable; try again shortly")
+            : TEXT("Voice query request failed"));
+        FailVoiceAnswer(Outcome == EFusionRequestOutcome::Succeeded ? EFusionRequestOutcome::Failed : Outcome);
+        return;
+    }
+
+    if (Stream.IsValid() && Stream->IsEventStream())
+    {
+        LogOnScreen(ELogVerbosity::Log, TEXT("Voice answer streamed (%d chars)"), StreamedAnswer.Len());
+        BroadcastVoiceAnswerToUI(StreamedQuestion, StreamedAnswer);
+
+        FFusionVoiceAnswerResult Answer;
+        Answer.Outcome = EFusionRequestOutcome::Succeeded;
+        Answer.Question = StreamedQuestion;
+        Answer.Answer = StreamedAnswer;
+        ResolveVoiceAnswer(Answer);
+        return;
+    }
+
+    TWeakObjectPtr<AFusionMode> WeakThis = this;
+    const uint32 Serial = VoiceQuerySerial;
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Response, Stream, Serial]()
+    {
+        // With a stream attached, a plain JSON answer went to the stream buffer instead of the response.
+        FusionResponse::FVoiceAnswer Result;
+        const TSharedPtr<FJsonValue> Root = Stream.IsValid()
+            ? FusionResponse::ParseJson(Stream->GetRawBody())
+            : FusionResponse::ParseJson(Response->GetContent());
+        const bool bParsed = FusionResponse::DecodeVoiceAnswer(Root, Result);
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, bParsed, Serial, Result = MoveTemp(Result)]()
+        {
+            AFusionMode* StrongThis = WeakThis.Get();
+            if (!StrongThis)
+            {
+                return;
+            }
+
+            // A newer query started while this body was decoding; its future must not receive this answer.
+            const bool bCurrent = StrongThis->VoiceQuerySerial == Serial;
+            if (!bParsed)
+            {
+                StrongThis->LogOnScreen(ELogVerbosity::Error, TEXT("Voice response could not be parsed"));
+                if (bCurrent)
+                {
+                    StrongThis->FailVoiceAnswer(EFusionRequestOutcome::Failed);
+                }
+                return;
+            }
+
+            StrongThis->LogOnScreen(ELogVerbosity::Log, TEXT("Voice answer received (%d chars)"), Result.Answer.Len());
+            StrongThis->BroadcastVoiceAnswerToUI(Result.Question, Result.Answer);
+            if (bCurrent)
+            {
+                FFusionVoiceAnswerResult Answer;
+                Answer.Outcome = EFusionRequestOutcome::Succeeded;
+                Answer.Question = Result.Question;
+                Answer.Answer = Result.Answer;
+                StrongThis->ResolveVoiceAnswer(Answer);
+            }
+        });
+    });
+}
+
+void AFusionMode::DrainVoiceAnswerStream(const TSharedPtr<FFusionVoiceAnswerStream, ESPMode::ThreadSafe>& Stream)
+{
+    if (!Stream.IsValid() || Stream != ActiveVoiceStream)
+    {
+        return;
+    }
+
+    TArray<FFusionVoiceAnswerStream::FEvent> Events;
+    Stream->DrainEvents(Events);
+
+    for (const FFusionVoiceAnswerStream::FEvent& Event : Events)
+    {
+        switch (Event.Type)
+        {
+        case FFusionVoiceAnswerStream::EEventType::Question:
+            StreamedQuestion = Event.Text;
+            OnVoiceAnswerChunkReceived.Broadcast(StreamedQuestion, FString());
+            break;
+        case FFusionVoiceAnswerStream::EEventType::Token:
+            StreamedAnswer.Append(Event.Text);
+            OnVoiceAnswerChunkReceived.Broadcast(StreamedQuestion, Event.Text);
+            break;
+        case FFusionVoiceAnswerStream::EEventType::Answer:
+            // Authoritative full text from the server; replaces whatever was assembled from tokens.
+            StreamedAnswer = Event.Text;
+            break;
+        }
+    }
+}
+
+void AFusionMode::ResolveDescriptionWaiters(const FFusionDescriptionResult& Result)
+{
+    TArray<FDescriptionWaiter> Waiters;
+    if (!DescriptionWaiters.RemoveAndCopyValue(Result.ObjectId, Waiters))
+    {
+        return;
+    }
+
+    // Continuations run inline and may request the same object again, so the entry is removed first.
+    for (const FDescriptionWaiter& Waiter : Waiters)
+    {
+        Waiter.Promise->SetValue(Result);
+    }
+}
+
+void AFusionMode::FailDescriptionWaiters(const FString& ObjectId, EFusionRequestOutcome Outcome)
+{
+    if (!DescriptionWaiters.Contains(ObjectId))
+    {
+        return;
+    }
+
+    FFusionDescriptionResult Result;
+    Result.Outcome = Outcome;
+    Result.ObjectId = ObjectId;
+    ResolveDescriptionWaiters(Result);
+}
+
+void AFusionMode::CancelDescriptionWaiter(const FString& ObjectId, uint64 WaiterId)
+{
+    TArray<FDescriptionWaiter>* Waiters = DescriptionWaiters.Find(ObjectId);
+    const int32 Index = Waiters ? Waiters->IndexOfByPredicate([WaiterId](const FDescriptionWaiter& Waiter) { return Waiter.Id == WaiterId; }) : INDEX_NONE;
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    const TSharedPtr<TPromise<FFusionDescriptionResult>> Promise = (*Waiters)[Index].Promise;
+    Waiters->RemoveAt(Index);
+    if (Waiters->Num() == 0)
+    {
+        // Nobody else is waiting; a batch in flight cannot drop a single object and simply finishes.
+        DescriptionWaiters.Remove(ObjectId);
+        CancelRequest(FString::Printf(TEXT("describe:%s"), *ObjectId));
+    }
+
+    FFusionDescriptionResult Result;
+    Result.Outcome = EFusionRequestOutcome::Cancelled;
+    Result.ObjectId = ObjectId;
+    Promise->SetValue(MoveTemp(Result));
+}
+
+void AFusionMode::ResolveVoiceAnswer(const FFusionVoiceAnswerResult& Result)
+{
+    // Cleared before resolving so a continuation can start the next query.
+    if (const TSharedPtr<TPromise<FFusionVoiceAnswerResult>> Promise = MoveTemp(PendingVoiceAnswer))
+    {
+        Promise->SetValue(Result);
+    }
+}
+
+void AFusionMode::FailVoiceAnswer(EFusionRequestOutcome Outcome)
+{
+    if (PendingVoiceAnswer.IsValid())
+    {
+        FFusionVoiceAnswerResult Result;
+        Result.Outcome = Outcome;
+        ResolveVoiceAnswer(Result);
     }
 }
 
 void AFusionMode::BroadcastDescriptionToUI(const FString& ObjectId, const FString& Description, const FString& TtsUrl)
 {
     LogOnScreen(ELogVerbosity::Log, TEXT("Broadcasting description for %s"), *ObjectId);
+    CacheDescription(ObjectId, Description, TtsUrl);
+
+    FFusionDescriptionResult Result;
+    Result.Outcome = EFusionRequestOutcome::Succeeded;
+    Result.ObjectId = ObjectId;
+    Result.Description = Description;
+    Result.TtsUrl = TtsUrl;
+    ResolveDescriptionWaiters(Result);
+
+    // Start fetching the narration while the text is on screen so pressing play does not wait on the network.
+    if (TtsComponent && !TtsUrl.IsEmpty())
+    {
+        TtsComponent->PrefetchTts(TtsUrl);
+    }
+
     OnObjectDescriptionReceived.Broadcast(ObjectId, Description, TtsUrl);
 }
 
@@ -468,6 +1983,17 @@ void AFusionMode::BroadcastVoiceAnswerToUI(const FString& Q, const FString& A)
 
 void AFusionMode::BroadcastBackToUI()
 {
+    // Once the user backs out, speculative lookups for the previous view are no longer useful. TTS prefetches are
+    // kept: the clips stay cached and the same objects are likely to be described again.
+    if (RequestScheduler.IsValid())
+    {
+        RequestScheduler->CancelPriority(EFusionRequestPriority::Speculative, TEXT("describe"));
+    }
+    if (SocketChannel.IsValid())
+    {
+        SocketChannel->CancelPriority(EFusionRequestPriority::Speculative);
+    }
+
     LogOnScreen(ELogVerbosity::Log, TEXT("Broadcasting back gesture"));
     OnBackRequested.Broadcast();
 }
@@ -1,15 +1,40 @@
 ﻿#pragma once
 
+#include <atomic>
+
 #include "CoreMinimal.h"
+#include "Async/Future.h"
 #include "GameFramework/GameModeBase.h"
+#include "HAL/CriticalSection.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
+#include "FusionRequestScheduler.h"
+#include "FusionClockSync.h"
 #include "FusionMode.generated.h"
 
 class IWebSocket;
+class FFusionVoiceAnswerStream;
+class FFusionSocketChannel;
+class IFusionGestureSource;
+class FFusionGestureSequenceTracker;
+struct FFusionGestureFrame;
 class FJsonObject;
 class FJsonValue;
 class UHandViewportMapperComponent;
+class UFusionTtsComponent;
+enum class EFusionState : uint8;
+
+/** Where AFusionMode takes gesture frames from. */
+UENUM(BlueprintType)
+enum class EFusionGestureTransport : uint8
+{
+    /** JSON frames on the gesture WebSocket. */
+    WebSocket,
+    /** Binary frames from a POSIX shared-memory ring written by a tracker on the same machine (Linux only). */
+    SharedMemory,
+    /** JSON frames as UDP datagrams; late or out-of-order frames are dropped instead of queued. */
+    Udp
+};
 
 USTRUCT(BlueprintType)
 struct FFusionHandLandmark
@@ -33,13 +58,194 @@ struct FFusionHandSnapshot
     
     UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
     FString state;
+
+    /** "Left" or "Right" when the tracker reports it; stable while the hand stays tracked, unlike its array index. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    FString Handedness;
+
+    /**
+     * Bit N is set when landmark N is present. x_y_z then holds only those landmarks, in ascending id order.
+     * 0 means x_y_z is dense and lists every landmark from 0.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int32 LandmarkMask = 0;
+
+    /** Index of the landmark's x in x_y_z, or INDEX_NONE when this snapshot does not carry it. */
+    int32 GetLandmarkOffset(int32 LandmarkId) const
+    {
+        if (LandmarkId < 0 || LandmarkId >= 32)
+        {
+            return INDEX_NONE;
+        }
+
+        int32 Slot = LandmarkId;
+        if (LandmarkMask != 0)
+        {
+            const uint32 Mask = static_cast<uint32>(LandmarkMask);
+            if (!(Mask & (1u << LandmarkId)))
+            {
+                return INDEX_NONE;
+            }
+            Slot = FMath::CountBits(Mask & ((1u << LandmarkId) - 1u));
+        }
+
+        const int32 Offset = Slot * 3;
+        return x_y_z.IsValidIndex(Offset + 1) ? Offset : INDEX_NONE;
+    }
+};
+
+/** Delivery counters of the active gesture transport since it was created. */
+USTRUCT(BlueprintType)
+struct FFusionGestureTransportStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    FString Transport;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    bool bConnected = false;
+
+    /** Frames that reached this client, whether or not they were delivered. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int32 FramesReceived = 0;
+
+    /** Frames handed to the gesture pipeline. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int32 FramesDelivered = 0;
+
+    /** Frames the sender produced that never arrived (sequence gaps) or were overwritten before they were read. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int32 FramesLost = 0;
+
+    /** Frames that arrived after a newer one had already been delivered. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int32 FramesReordered = 0;
+
+    /** Frames dropped because a newer one arrived in the same poll. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int32 FramesSuperseded = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int32 FramesMalformed = 0;
+};
+
+/** Sequence accounting of one gesture stream as seen by the gesture pipeline, after any transport-level dropping. */
+USTRUCT(BlueprintType)
+struct FFusionGestureStreamStats
+{
+    GENERATED_BODY()
+
+    /** The frame's "source" field (e.g. a camera id), or the transport name when frames carry none. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    FString Source;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int32 FramesReceived = 0;
+
+    /** Sequence numbers skipped and not filled by a late frame since. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int32 FramesLost = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int32 FramesDuplicated = 0;
+
+    /** Frames that arrived after a higher sequence number. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int32 FramesReordered = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int32 SequenceRestarts = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    int64 LastSequence = INDEX_NONE;
+
+    /** Frames delivered per second over the last few seconds. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    float DeliveredFps = 0.f;
+
+    /** Frames the tracker produced per second over the same window, from the advance of the sequence number. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    float CaptureFps = 0.f;
+
+    /** Share of the frames produced in the window that were lost. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    float WindowLossRatio = 0.f;
+
+    /** Mean capture-to-processing latency over the window, using the tracker clock estimate; -1 until one exists. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Gestures")
+    float LatencyMs = -1.f;
+};
+
+/** Typed outcome of RequestObjectDescriptionAsync. */
+USTRUCT(BlueprintType)
+struct FFusionDescriptionResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    EFusionRequestOutcome Outcome = EFusionRequestOutcome::Failed;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    FString ObjectId;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    FString Description;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    FString TtsUrl;
+
+    /** Answered from the description cache because the backend could not be reached. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    bool bFromCache = false;
+
+    bool IsSuccess() const { return Outcome == EFusionRequestOutcome::Succeeded; }
+};
+
+/** Typed outcome of SendVoiceQueryAsync. */
+USTRUCT(BlueprintType)
+struct FFusionVoiceAnswerResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    EFusionRequestOutcome Outcome = EFusionRequestOutcome::Failed;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    FString Question;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    FString Answer;
+
+    bool IsSuccess() const { return Outcome == EFusionRequestOutcome::Succeeded; }
+};
+
+/**
+ * Lets the caller of an async AFusionMode request give up on it. Cancel() may be called from any thread; the request is
+ * dropped on the game thread and its future resolves with EFusionRequestOutcome::Cancelled.
+ */
+class FUSION_API FFusionCancellationToken
+{
+public:
+    void Cancel();
+    bool IsCancelled() const { return bCancelled; }
+
+    /** Game thread. Runs Callback once the token is cancelled, immediately if it already is. */
+    void OnCancelled(TFunction<void()>&& Callback);
+
+private:
+    FCriticalSection Lock;
+    TArray<TFunction<void()>> Callbacks;
+    std::atomic<bool> bCancelled { false };
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnObjectDescriptionReceived, const FString&, ObjectId, const FString&, Description, const FString&, TtsUrl);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnVoiceAnswerReceived, const FString&, Transcript, const FString&, TtsUrl);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnVoiceAnswerChunkReceived, const FString&, Question, const FString&, Chunk);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGesturePayloadReceived, const FString&, RawMessage);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGestureFrameReceived, const TArray<FFusionHandSnapshot>&, Hands);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnBackRequested);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBackendHealthChanged, const FString&, Endpoint, EFusionCircuitState, State);
 
 /**
  * AFusionMode centralises all AI ↔ Unreal communication for gesture streams, description lookups, and voice queries.
@@ -55,15 +261,106 @@ public:
 
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void Tick(float DeltaSeconds) override;
 
     /** Requests a description payload for the provided object id via REST. */
     UFUNCTION(BlueprintCallable, Category = "Fusion|Networking")
     void RequestObjectDescription(const FString& ObjectId);
 
+    /** Queues a low-priority description request for an object the user may look at next. */
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Networking")
+    void PrefetchObjectDescription(const FString& ObjectId);
+
+    /** Requests descriptions for several objects at once, in as few round trips as the backend allows. */
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Networking")
+    void RequestObjectDescriptions(const TArray<FString>& ObjectIds);
+
     /** Sends a recorded wav file to the voice query endpoint for LLM processing. */
     UFUNCTION(BlueprintCallable, Category = "Fusion|Networking")
     void SendVoiceQuery(const FString& FilePath);
 
+    /** Sends an already encoded wav payload to the voice query endpoint without touching disk. */
+    void SendVoiceQueryData(TArray<uint8>&& WavData);
+
+    /**
+     * Requests a description and resolves on the game thread with it, with a cached copy when the backend is failing,
+     * or with the failure outcome. Concurrent calls for the same object share one request; OnObjectDescriptionReceived
+     * still fires. Cancelling the token drops the request once no other caller is waiting on it.
+     */
+    TFuture<FFusionDescriptionResult> RequestObjectDescriptionAsync(const FString& ObjectId, EFusionRequestPriority Priority = EFusionRequestPriority::Description,
+        const TSharedPtr<FFusionCancellationToken, ESPMode::ThreadSafe>& CancellationToken = nullptr);
+
+    /** Sends a voice query and resolves on the game thread with the full answer; a newer query resolves this one as Cancelled. */
+    TFuture<FFusionVoiceAnswerResult> SendVoiceQueryAsync(TArray<uint8>&& WavData, const TSharedPtr<FFusionCancellationToken, ESPMode::ThreadSafe>& CancellationToken = nullptr);
+
+    /**
+     * Cancels a queued or in-flight request by key ("voice-query" or "describe:<ObjectId>"). An object fetched as part
+     * of a batch is dropped from it, and the batch itself is cancelled once none of its objects are wanted any more.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Networking")
+    bool CancelRequest(const FString& Key);
+
+    /** Queue depth, in-flight counts and wait times per priority class. */
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Networking")
+    FFusionRequestSchedulerStats GetRequestSchedulerStats() const;
+
+    /** Writes per-endpoint HTTP phase histograms (queue, upload, server, download, total) to CSV (relative to Saved/Telemetry); same as Fusion.Net.DumpTimings. */
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Networking")
+    bool DumpRequestTimings(const FString& FilePath) const;
+
+    /**
+     * Asks the tracker for these landmark ids (0-20) in addition to those other consumers registered. The union is
+     * sent upstream and frames carry only those landmarks; with no registrations every landmark is streamed.
+     * Returns a handle for UnregisterLandmarkSubscription.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Gestures")
+    int32 RegisterLandmarkSubscription(const TArray<int32>& LandmarkIds);
+
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Gestures")
+    void UnregisterLandmarkSubscription(int32 Handle);
+
+    /** Union of all registered landmarks, bit per id; 0 when every landmark is streamed. */
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Gestures")
+    int32 GetSubscribedLandmarkMask() const;
+
+    /**
+     * Tracker coordinates of a landmark, Z being 0 for 2D trackers. Works on dense and sparse snapshots alike; false
+     * when the snapshot does not carry the landmark, e.g. because no subscription asked for it.
+     */
+    UFUNCTION(BlueprintPure, Category = "Fusion|Gestures")
+    static bool GetHandLandmarkLocation(const FFusionHandSnapshot& Hand, int32 LandmarkId, FVector& OutLocation);
+
+    /**
+     * Tracker capture time in seconds of the frame being broadcast by OnGestureFrameReceived, or of the last one
+     * outside of it; 0 if the tracker sends none. Frames unpacked from one batched message differ only in this.
+     */
+    UFUNCTION(BlueprintPure, Category = "Fusion|Gestures")
+    double GetGestureFrameTimestamp() const { return CurrentGestureFrameTimestamp; }
+
+    /**
+     * Tracker clock minus local clock (FPlatformTime::Seconds) and the round trip to the tracker, estimated from the
+     * keep-alive ping/pong. False until the tracker answered a ping with its timestamps.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Gestures")
+    bool GetTrackerClockEstimate(double& OutOffsetSeconds, double& OutRoundTripSeconds) const;
+
+    /** Converts a tracker timestamp, e.g. GetGestureFrameTimestamp, to local FPlatformTime::Seconds. */
+    UFUNCTION(BlueprintPure, Category = "Fusion|Gestures")
+    double TrackerTimeToLocal(double TrackerTime) const { return TrackerClock.ToLocalTime(TrackerTime); }
+
+    const FFusionClockSync& GetTrackerClock() const { return TrackerClock; }
+
+    /** Per-stream sequence accounting and rates; shown on screen with Fusion.Gesture.StreamOverlay 1. */
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Gestures")
+    TArray<FFusionGestureStreamStats> GetGestureStreamStats() const;
+
+    /** Loss and reordering counters of the shared-memory or UDP gesture transport; empty for the WebSocket. */
+    UFUNCTION(BlueprintCallable, Category = "Fusion|Gestures")
+    FFusionGestureTransportStats GetGestureTransportStats() const;
+
+    /** Shared scheduler for components that issue their own requests; null outside of play. */
+    TSharedPtr<FFusionRequestScheduler> GetRequestScheduler() const { return RequestScheduler; }
+
     /** Broadcast whenever a gesture frame arrives over the WebSocket. */
     UPROPERTY(BlueprintAssignable, Category = "Fusion|Events")
     FOnGesturePayloadReceived OnGesturePayloadReceived;
@@ -80,10 +377,18 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Fusion|Events")
     FOnVoiceAnswerReceived OnVoiceAnswerReceived;
 
+    /** Broadcast for every streamed piece of a voice answer, before OnVoiceAnswerReceived delivers the full text. */
+    UPROPERTY(BlueprintAssignable, Category = "Fusion|Events")
+    FOnVoiceAnswerChunkReceived OnVoiceAnswerChunkReceived;
+
     /** Broadcast when a back/fist gesture is detected. */
     UPROPERTY(BlueprintAssignable, Category = "Fusion|Events")
     FOnBackRequested OnBackRequested;
 
+    /** Broadcast when an AI endpoint's circuit breaker opens, goes half-open or closes again. */
+    UPROPERTY(BlueprintAssignable, Category = "Fusion|Events")
+    FOnBackendHealthChanged OnBackendHealthChanged;
+
 protected:
     /** WebSocket bootstrapping and teardown. */
     void InitializeGestureWebSocket();
@@ -92,49 +397,302 @@ protected:
     void HandleWebSocketConnected();
     void HandleWebSocketConnectionError(const FString& Error);
     void HandleWebSocketMessage(const FString& Message);
+    void HandleWebSocketBinaryMessage(const void* Data, SIZE_T Size, bool bIsLastFragment);
     void HandleWebSocketClosed(int32 StatusCode, const FString& Reason, bool bWasClean);
 
     void ScheduleGestureKeepAlive();
     void SendGestureKeepAlive();
-
-    void OnDescriptionRequestComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-    void OnVoiceQueryComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+    void HandleGesturePong(const FJsonObject& Message);
+
+    /** Control messages telling the tracker what to stream: "subscribe" once per connection, then "fps" on rate changes. */
+    void SendGestureSubscription();
+    void UpdateGestureStreamRate();
+
+    UFUNCTION()
+    void HandleMapperStateChanged(EFusionState State);
+
+    void EnqueueDescriptionRequest(const FString& ObjectId, EFusionRequestPriority Priority);
+    bool SendDescriptionOverSocket(const FString& ObjectId, EFusionRequestPriority Priority);
+    void EnqueueSingleDescriptionRequest(const FString& ObjectId, EFusionRequestPriority Priority);
+    void EnqueueDescriptionBatch(const TArray<FString>& ObjectIds, EFusionRequestPriority Priority);
+    void SendDescriptionBatches(const TArray<FString>& ObjectIds, EFusionRequestPriority Priority);
+    void FlushDescriptionBatch();
+    bool CanBatchDescriptions() const;
+    bool CancelBatchedDescription(const FString& ObjectId);
+    void StartVoiceQuery(TArray<uint8>&& WavData, TSharedPtr<TPromise<FFusionVoiceAnswerResult>> Promise);
+    void SendVoiceQueryOverHttp(TArray<uint8>&& WavData);
+    bool SendVoiceQueryOverSocket(const TSharedRef<TArray<uint8>>& WavData);
+    bool HandleSocketVoiceReply(const FJsonObject& Reply);
+
+    /** Routes replies and server pushes arriving on the gesture socket; returns false for gesture frames. */
+    bool HandleSocketChannelMessage(const FJsonObject& Message);
+
+    void TickRequestScheduler();
+    void HandleCircuitStateChanged(const FString& Endpoint, EFusionCircuitState State);
+
+    /** Re-broadcasts the last description received for ObjectId; returns false if none is cached. */
+    bool ServeCachedDescription(const FString& ObjectId);
+    void CacheDescription(const FString& ObjectId, const FString& Description, const FString& TtsUrl);
+
+    void OnDescriptionRequestComplete(const FString& ObjectId, FHttpResponsePtr Response, EFusionRequestOutcome Outcome);
+    void OnDescriptionBatchComplete(const FString& BatchKey, TArray<FString> ObjectIds, EFusionRequestPriority Priority, FHttpResponsePtr Response, EFusionRequestOutcome Outcome);
+    void OnVoiceQueryComplete(FHttpResponsePtr Response, EFusionRequestOutcome Outcome, TSharedPtr<FFusionVoiceAnswerStream, ESPMode::ThreadSafe> Stream);
+    void DrainVoiceAnswerStream(const TSharedPtr<FFusionVoiceAnswerStream, ESPMode::ThreadSafe>& Stream);
+
+    void ResolveDescriptionWaiters(const FFusionDescriptionResult& Result);
+    void FailDescriptionWaiters(const FString& ObjectId, EFusionRequestOutcome Outcome);
+    void CancelDescriptionWaiter(const FString& ObjectId, uint64 WaiterId);
+    void ResolveVoiceAnswer(const FFusionVoiceAnswerResult& Result);
+    void FailVoiceAnswer(EFusionRequestOutcome Outcome);
 
     void BroadcastDescriptionToUI(const FString& ObjectId, const FString& Description, const FString& TtsUrl);
     void BroadcastVoiceAnswerToUI(const FString& Transcript, const FString& TtsUrl);
     void BroadcastBackToUI();
 
-    void PopulateHandsFromJson(const TSharedPtr<FJsonObject>& JsonPayload, TArray<FFusionHandSnapshot>& OutHands) const;
+    /** Common gesture pipeline for every transport: broadcasts the hands and reacts to point and back gestures. */
+    void ProcessGestureFrame(const FFusionGestureFrame& Frame);
+    void PollGestureSource();
+    void UpdateGestureStreamOverlay();
 
 protected:
     /** WebSocket URL supplying gesture frames and hand state. */
     UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking")
     FString GestureStreamUrl;
 
+    /**
+     * Transport for gesture frames. The WebSocket stays connected for keep-alives and multiplexed requests either
+     * way, but gesture frames arriving on it are ignored while another transport is selected.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking")
+    EFusionGestureTransport GestureTransport;
+
+    /** POSIX shared-memory object holding the gesture ring, e.g. "/fusion_gestures". */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (EditCondition = "GestureTransport == EFusionGestureTransport::SharedMemory"))
+    FString GestureSharedMemoryName;
+
+    /** Local UDP port gesture datagrams are sent to. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (EditCondition = "GestureTransport == EFusionGestureTransport::Udp", ClampMin = "1", ClampMax = "65535"))
+    int32 GestureUdpPort;
+
+    /** IPv4 address the gesture UDP socket listens on; loopback by default, "0.0.0.0" to accept trackers on other hosts. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (EditCondition = "GestureTransport == EFusionGestureTransport::Udp"))
+    FString GestureUdpBindAddress;
+
     /** REST endpoint for triggering description requests. */
     UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking")
     FString DescribeEndpoint;
 
+    /** REST endpoint accepting {"object_ids": [...]} and answering {"results": [...]}; empty disables batching. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking")
+    FString DescribeBatchEndpoint;
+
+    /** Further servers answering the same API as DescribeEndpoint and DescribeBatchEndpoint. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking")
+    TArray<FString> DescribeEndpointReplicas;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking")
+    TArray<FString> DescribeBatchEndpointReplicas;
+
+    /** Prefetches arriving within this many seconds are sent as one batch (0 = never batch). Committed requests never wait. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0.0"))
+    float DescriptionBatchWindowSeconds;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "1"))
+    int32 MaxDescriptionBatchSize;
+
     /** REST endpoint for uploading wav voice queries. */
     UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking")
     FString VoiceQueryEndpoint;
 
+    /** Fallback voice servers; each query goes to the healthiest one but is never duplicated. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking")
+    TArray<FString> VoiceQueryEndpointReplicas;
+
+    /** Asks the voice endpoint for a text/event-stream answer and forwards tokens as they arrive. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking")
+    bool bStreamVoiceAnswers;
+
+    /**
+     * Sends description and voice requests over the gesture WebSocket while it is connected, tagged with request ids,
+     * instead of opening HTTP requests. Falls back to the REST endpoints when the socket drops or the server declines.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking")
+    bool bMultiplexRequestsOverGestureSocket;
+
     /** Interval in seconds for sending lightweight keep-alive pings over the WebSocket. */
     UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0.1"))
     float GestureKeepAliveInterval;
 
+    /** Frame rate requested from the tracker while hands are tracked; 0 follows the game's own frame rate. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0"))
+    float GestureStreamFps;
+
+    /** Rate requested once no hand has been seen for GestureIdleDelaySeconds; the next frame with a hand restores the full rate. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0.5"))
+    float GestureIdleFps;
+
+    /** Seconds without hands before the stream is throttled to GestureIdleFps (0 = never). */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0"))
+    float GestureIdleDelaySeconds;
+
+    /** Rate requested while the mapper shows a description and only watches for the stop gesture. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0.5"))
+    float GestureDescriptionFps;
+
+    /** Frame fields the tracker should send ("hands", "gesture", "object_id", ...); empty asks for everything. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking")
+    TArray<FString> GestureStreamFields;
+
     /** Optional token or API key forwarded with REST requests. */
     UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking")
     FString ApiToken;
 
+    /** Maximum number of simultaneous requests per REST endpoint; further requests wait in the priority queue. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "1"))
+    int32 MaxConcurrentRequestsPerEndpoint;
+
+    /** Seconds a description request may spend queued plus in flight before it is dropped (0 = no deadline). */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0.0"))
+    float DescriptionDeadlineSeconds;
+
+    /** Seconds a voice query may spend queued plus in flight before it is dropped (0 = no deadline). */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0.0"))
+    float VoiceQueryDeadlineSeconds;
+
+    /** Extra attempts for a failed description request, spaced by jittered exponential backoff within its deadline. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0"))
+    int32 DescriptionMaxRetries;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0.0"))
+    float DescriptionRetryBaseDelaySeconds;
+
+    /** Consecutive failures (connection errors, 5xx, timeouts) that open an endpoint's circuit breaker (0 = never). */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0"))
+    int32 CircuitBreakerFailureThreshold;
+
+    /** Seconds an open breaker fails requests fast before letting a single probe through. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0.0"))
+    float CircuitBreakerOpenSeconds;
+
+    /**
+     * A description request still unanswered after this percentile of its replica's recent latency is duplicated to
+     * another replica, and the first answer wins (0 = no hedging). Needs at least one description replica.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float HedgePercentile;
+
+    /** Lower bound for the hedge delay, however fast the replica usually answers. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0.0"))
+    float HedgeMinDelaySeconds;
+
+    /** Hedge delay used while a replica has too few latency samples for a percentile (0 = do not hedge until measured). */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0.0"))
+    float HedgeFallbackDelaySeconds;
+
+    /** Descriptions kept to answer from while the description backend is failing. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Networking", meta = (ClampMin = "0"))
+    int32 MaxCachedDescriptions;
+
+    /** Development builds: serve the gesture stream and REST endpoints from the in-process mock backend. */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Testing")
+    bool bStartMockBackend;
+
+    /** Fusion.Mock.Start style arguments, e.g. "Fps=240 DescLatency=lognormal:0.5:0.8 DescErrorRate=0.1". */
+    UPROPERTY(EditDefaultsOnly, Category = "Fusion|Testing", meta = (EditCondition = "bStartMockBackend"))
+    FString MockBackendArgs;
+
 private:
     FTimerHandle GestureKeepAliveHandle;
     FTimerHandle GestureReconnectHandle;
     TSharedPtr<IWebSocket> GestureSocket;
 
+    FTimerHandle RequestSchedulerTickHandle;
+    TSharedPtr<FFusionRequestScheduler> RequestScheduler;
+    TSharedPtr<FFusionSocketChannel> SocketChannel;
+
+    /** Prefetched object ids collected during the current batch window, in arrival order. */
+    TArray<FString> PendingDescriptionBatch;
+    FTimerHandle DescriptionBatchHandle;
+
+    /** Scheduler key of the batch job fetching each object id; cancelled ids are removed. */
+    TMap<FString, FString> DescriptionBatchKeys;
+    int32 NextDescriptionBatchId = 0;
+
+    /** Stream of the voice query currently in flight; events from superseded streams are ignored. */
+    TSharedPtr<FFusionVoiceAnswerStream, ESPMode::ThreadSafe> ActiveVoiceStream;
+    FString StreamedQuestion;
+    FString StreamedAnswer;
+
+    struct FDescriptionWaiter
+    {
+        uint64 Id = 0;
+        TSharedPtr<TPromise<FFusionDescriptionResult>> Promise;
+    };
+
+    /** Futures handed out by RequestObjectDescriptionAsync, per object id. */
+    TMap<FString, TArray<FDescriptionWaiter>> DescriptionWaiters;
+    uint64 NextDescriptionWaiterId = 1;
+
+    /** Future of the voice query in progress, and a serial that tells late answers of replaced queries apart. */
+    TSharedPtr<TPromise<FFusionVoiceAnswerResult>> PendingVoiceAnswer;
+    uint32 VoiceQuerySerial = 0;
+
+    struct FCachedDescription
+    {
+        FString Description;
+        FString TtsUrl;
+        double LastUsed = 0.0;
+    };
+
+    TMap<FString, FCachedDescription> DescriptionCache;
+
+    /** Cleared the first time the batch endpoint answers as if it does not exist. */
+    bool bDescriptionBatchSupported = true;
+
+    /** Source of gesture frames when GestureTransport is not the WebSocket; polled every tick. */
+    TSharedPtr<IFusionGestureSource> GestureSource;
+
+    enum class EGestureStreamMode : uint8
+    {
+        Active,
+        Idle,
+        Description
+    };
+
+    /** Last mode and rate requested from the tracker; unset until the subscription went out on the current connection. */
+    TOptional<EGestureStreamMode> SentGestureStreamMode;
+    float SentGestureStreamFps = 0.f;
+    double LastGestureStreamRateTime = 0.0;
+
+    /** Landmark masks per RegisterLandmarkSubscription handle. */
+    TMap<int32, int32> LandmarkSubscriptions;
+    int32 NextLandmarkSubscriptionHandle = 1;
+
+    /** Tracker clock estimate; the tracker must stamp pongs with the clock it stamps frames with. */
+    FFusionClockSync TrackerClock;
+
+    double LastHandSeenTime = 0.0;
+    double CurrentGestureFrameTimestamp = 0.0;
+
+    /** Sequence trackers per gesture stream, keyed like FFusionGestureStreamStats::Source. */
+    TMap<FString, TSharedPtr<FFusionGestureSequenceTracker>> GestureSequenceTrackers;
+    FString DefaultGestureStreamName;
+    double LastGestureOverlayUpdate = 0.0;
+    float SmoothedGameFps = 0.f;
+    bool bMapperInDescription = false;
+
+    /** Fragments of a binary gesture frame; some servers send JSON as binary messages. */
+    TArray<uint8> GestureBinaryBuffer;
+
+    /** Set when this game mode started the mock backend and must stop it again. */
+    bool bOwnsMockBackend = false;
+
     void LogOnScreen(ELogVerbosity::Type Verbosity, const TCHAR* Format, ...) const;
     FColor GetLogColor(ELogVerbosity::Type Verbosity) const;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fusion|Mapping", meta = (AllowPrivateAccess = "true"))
     UHandViewportMapperComponent* HandViewportMapper;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fusion|TTS", meta = (AllowPrivateAccess = "true"))
+    UFusionTtsComponent* TtsComponent;
 };
@@ -0,0 +1,766 @@
+#include "FusionRequestScheduler.h"
+
+#include "Algo/BinarySearch.h"
+#include "HttpModule.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFusionRequestScheduler, Log, All);
+
+namespace
+{
+    /** Successful responses remembered per endpoint for replica ranking and hedge delays. */
+    constexpr int32 MaxLatencySamples = 64;
+}
+
+FFusionRequestScheduler::FFusionRequestScheduler(int32 InMaxConcurrentPerEndpoint)
+    : MaxConcurrentPerEndpoint(FMath::Max(1, InMaxConcurrentPerEndpoint))
+{
+}
+
+FString FFusionRequestScheduler::MakeEndpointKey(const FString& Url)
+{
+    int32 QueryIndex = INDEX_NONE;
+    if (Url.FindChar(TEXT('?'), QueryIndex))
+    {
+        return Url.Left(QueryIndex);
+    }
+    return Url;
+}
+
+float FFusionRequestScheduler::GetLatencyPercentile(const FEndpointState& Endpoint, float Percentile)
+{
+    const TArray<float>& Sorted = Endpoint.SortedLatencySamples;
+    if (Sorted.Num() == 0)
+    {
+        return 0.f;
+    }
+
+    const int32 Index = FMath::CeilToInt(FMath::Clamp(Percentile, 0.f, 1.f) * Sorted.Num()) - 1;
+    return Sorted[FMath::Clamp(Index, 0, Sorted.Num() - 1)];
+}
+
+bool FFusionRequestScheduler::Enqueue(FFusionRequestJob&& Job)
+{
+    if (const TSharedPtr<FJobState> Existing = FindPending(Job.Key))
+    {
+        if (!Job.bSupersedeExisting)
+        {
+            // Keep the running job, but let a committed request promote a queued speculative one.
+            Promote(Job.Key, Job.Priority);
+            return false;
+        }
+
+        Cancel(Job.Key);
+    }
+
+    const TSharedPtr<FJobState> State = MakeShared<FJobState>();
+    State->Id = NextJobId++;
+    State->EnqueueTime = FPlatformTime::Seconds();
+    State->Job = MoveTemp(Job);
+
+    State->Urls.Add(State->Job.Url);
+    for (const FString& ReplicaUrl : State->Job.ReplicaUrls)
+    {
+        if (!ReplicaUrl.IsEmpty())
+        {
+            State->Urls.AddUnique(ReplicaUrl);
+        }
+    }
+    for (const FString& Url : State->Urls)
+    {
+        const FString EndpointKey = State->EndpointKeys.Num() == 0 && !State->Job.EndpointKey.IsEmpty() ? State->Job.EndpointKey : MakeEndpointKey(Url);
+        State->EndpointKeys.Add(EndpointKey);
+        UpdateCircuit(EndpointKey, Endpoints.FindOrAdd(EndpointKey), State->EnqueueTime);
+    }
+
+    if (AreAllReplicasOpen(*State))
+    {
+        // Fail fast so the caller can fall back to cached data instead of waiting on a dead backend.
+        Finish(State, nullptr, EFusionRequestOutcome::Rejected);
+        return true;
+    }
+
+    Queue.Add(State);
+    Pump();
+    return true;
+}
+
+bool FFusionRequestScheduler::Promote(const FString& Key, EFusionRequestPriority Priority)
+{
+    const TSharedPtr<FJobState> State = FindPending(Key);
+    if (!State.IsValid() || State->Attempts.Num() > 0 || Priority >= State->Job.Priority)
+    {
+        return false;
+    }
+
+    State->Job.Priority = Priority;
+    Pump();
+    return true;
+}
+
+bool FFusionRequestScheduler::Cancel(const FString& Key)
+{
+    const TSharedPtr<FJobState> State = FindPending(Key);
+    if (!State.IsValid())
+    {
+        return false;
+    }
+
+    Finish(State, nullptr, EFusionRequestOutcome::Cancelled);
+    Pump();
+    return true;
+}
+
+int32 FFusionRequestScheduler::CancelPriority(EFusionRequestPriority Priority, const FString& KeyPrefix)
+{
+    TArray<TSharedPtr<FJobState>> Matching;
+    for (const TSharedPtr<FJobState>& State : Queue)
+    {
+        if (State->Job.Priority == Priority && State->Job.Key.StartsWith(KeyPrefix))
+        {
+            Matching.Add(State);
+        }
+    }
+    for (const TPair<uint64, TSharedPtr<FJobState>>& Pair : InFlight)
+    {
+        if (Pair.Value->Job.Priority == Priority && Pair.Value->Job.Key.StartsWith(KeyPrefix))
+        {
+            Matching.Add(Pair.Value);
+        }
+    }
+
+    for (const TSharedPtr<FJobState>& State : Matching)
+    {
+        Finish(State, nullptr, EFusionRequestOutcome::Cancelled);
+    }
+
+    Pump();
+    return Matching.Num();
+}
+
+void FFusionRequestScheduler::CancelAll()
+{
+    TArray<TSharedPtr<FJobState>> Pending = Queue;
+    for (const TPair<uint64, TSharedPtr<FJobState>>& Pair : InFlight)
+    {
+        Pending.Add(Pair.Value);
+    }
+
+    for (const TSharedPtr<FJobState>& State : Pending)
+    {
+        Finish(State, nullptr, EFusionRequestOutcome::Cancelled);
+    }
+}
+
+bool FFusionRequestScheduler::IsPending(const FString& Key) const
+{
+    return FindPending(Key).IsValid();
+}
+
+void FFusionRequestScheduler::Tick()
+{
+    const double Now = FPlatformTime::Seconds();
+
+    TArray<TSharedPtr<FJobState>> Overdue;
+    for (const TSharedPtr<FJobState>& State : Queue)
+    {
+        if (IsExpired(*State, Now))
+        {
+            Overdue.Add(State);
+        }
+    }
+    for (const TPair<uint64, TSharedPtr<FJobState>>& Pair : InFlight)
+    {
+        if (IsExpired(*Pair.Value, Now))
+        {
+            Overdue.Add(Pair.Value);
+        }
+    }
+
+    for (const TSharedPtr<FJobState>& State : Overdue)
+    {
+        UE_LOG(LogFusionRequestScheduler, Warning, TEXT("Request '%s' expired after %.2fs"), *State->Job.Key, Now - State->EnqueueTime);
+        for (const FAttempt& Attempt : State->Attempts)
+        {
+            // A request that hangs until its deadline is the typical stalled-backend symptom.
+            RecordEndpointResult(State->EndpointKeys[Attempt.ReplicaIndex], false);
+        }
+        Finish(State, nullptr, EFusionRequestOutcome::Expired);
+    }
+
+    TArray<FString> EndpointKeys;
+    Endpoints.GetKeys(EndpointKeys);
+    for (const FString& EndpointKey : EndpointKeys)
+    {
+        if (FEndpointState* Endpoint = Endpoints.Find(EndpointKey))
+        {
+            UpdateCircuit(EndpointKey, *Endpoint, Now);
+        }
+    }
+
+    TArray<TSharedPtr<FJobState>> Running;
+    InFlight.GenerateValueArray(Running);
+    for (const TSharedPtr<FJobState>& State : Running)
+    {
+        TryHedge(State, Now);
+    }
+
+    Pump();
+}
+
+void FFusionRequestScheduler::SetMaxConcurrentPerEndpoint(int32 InMaxConcurrentPerEndpoint)
+{
+    MaxConcurrentPerEndpoint = FMath::Max(1, InMaxConcurrentPerEndpoint);
+    Pump();
+}
+
+void FFusionRequestScheduler::SetCircuitBreakerSettings(const FFusionCircuitBreakerSettings& InSettings)
+{
+    BreakerSettings = InSettings;
+}
+
+void FFusionRequestScheduler::SetHedgingSettings(const FFusionHedgingSettings& InSettings)
+{
+    HedgingSettings = InSettings;
+}
+
+EFusionCircuitState FFusionRequestScheduler::GetCircuitState(const FString& Url) const
+{
+    const FEndpointState* Endpoint = Endpoints.Find(MakeEndpointKey(Url));
+    return Endpoint ? Endpoint->State : EFusionCircuitState::Closed;
+}
+
+FFusionRequestSchedulerStats FFusionRequestScheduler::GetStats() const
+{
+    FFusionRequestSchedulerStats Result;
+    FFusionRequestClassStats* ClassStats[3] = { &Result.Voice, &Result.Description, &Result.Speculative };
+
+    for (int32 Index = 0; Index < static_cast<int32>(UE_ARRAY_COUNT(Counters)); ++Index)
+    {
+        *ClassStats[Index] = Counters[Index].Stats;
+        ClassStats[Index]->QueueDepth = 0;
+        ClassStats[Index]->InFlight = 0;
+        ClassStats[Index]->AverageWaitSeconds = Counters[Index].Stats.Dispatched > 0
+            ? static_cast<float>(Counters[Index].TotalWaitSeconds / Counters[Index].Stats.Dispatched)
+            : 0.f;
+    }
+
+    for (const TSharedPtr<FJobState>& State : Queue)
+    {
+        ++ClassStats[static_cast<int32>(State->Job.Priority)]->QueueDepth;
+    }
+    for (const TPair<uint64, TSharedPtr<FJobState>>& Pair : InFlight)
+    {
+        ++ClassStats[static_cast<int32>(Pair.Value->Job.Priority)]->InFlight;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    for (const TPair<FString, FEndpointState>& Pair : Endpoints)
+    {
+        FFusionEndpointHealth& Health = Result.Endpoints.Add_GetRef(Pair.Value.Health);
+        Health.Endpoint = Pair.Key;
+        Health.State = Pair.Value.State;
+        Health.ConsecutiveFailures = Pair.Value.ConsecutiveFailures;
+        Health.SecondsUntilProbe = Pair.Value.State == EFusionCircuitState::Open
+            ? FMath::Max(0.f, BreakerSettings.OpenSeconds - static_cast<float>(Now - Pair.Value.OpenedAt))
+            : 0.f;
+        Health.LatencyP50Seconds = GetLatencyPercentile(Pair.Value, 0.5f);
+        Health.LatencyP95Seconds = GetLatencyPercentile(Pair.Value, 0.95f);
+        Health.LatencySamples = Pair.Value.LatencySamples.Num();
+    }
+
+    return Result;
+}
+
+TSharedPtr<FFusionRequestScheduler::FJobState> FFusionRequestScheduler::FindPending(const FString& Key) const
+{
+    if (Key.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    for (const TSharedPtr<FJobState>& State : Queue)
+    {
+        if (State->Job.Key == Key)
+        {
+            return State;
+        }
+    }
+    for (const TPair<uint64, TSharedPtr<FJobState>>& Pair : InFlight)
+    {
+        if (Pair.Value->Job.Key == Key)
+        {
+            return Pair.Value;
+        }
+    }
+    return nullptr;
+}
+
+void FFusionRequestScheduler::Pump()
+{
+    // Jobs whose replicas all tripped while they were waiting are rejected instead of sitting out their deadline.
+    TArray<TSharedPtr<FJobState>> Rejected;
+    for (const TSharedPtr<FJobState>& State : Queue)
+    {
+        if (AreAllReplicasOpen(*State))
+        {
+            Rejected.Add(State);
+        }
+    }
+    for (const TSharedPtr<FJobState>& State : Rejected)
+    {
+        Finish(State, nullptr, EFusionRequestOutcome::Rejected);
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    for (;;)
+    {
+        int32 BestIndex = INDEX_NONE;
+        int32 BestReplica = INDEX_NONE;
+        for (int32 Index = 0; Index < Queue.Num(); ++Index)
+        {
+            const FJobState& Candidate = *Queue[Index];
+            if (Candidate.NotBefore > Now)
+            {
+                continue;
+            }
+            if (BestIndex != INDEX_NONE && Candidate.Job.Priority >= Queue[BestIndex]->Job.Priority)
+            {
+                continue;
+            }
+
+            const int32 Replica = PickReplica(Candidate, INDEX_NONE);
+            if (Replica != INDEX_NONE)
+            {
+                BestIndex = Index;
+                BestReplica = Replica;
+            }
+        }
+
+        if (BestIndex == INDEX_NONE)
+        {
+            return;
+        }
+
+        const TSharedPtr<FJobState> State = Queue[BestIndex];
+        Queue.RemoveAt(BestIndex);
+        Dispatch(State, BestReplica);
+    }
+}
+
+int32 FFusionRequestScheduler::PickReplica(const FJobState& State, int32 ExcludeReplica) const
+{
+    // Prefer a closed circuit, then fewer recent failures, then the lower median latency; ties keep list order.
+    int32 BestReplica = INDEX_NONE;
+    int32 BestFailures = 0;
+    float BestLatency = 0.f;
+    bool bBestClosed = false;
+
+    for (int32 Replica = 0; Replica < State.EndpointKeys.Num(); ++Replica)
+    {
+        if (Replica == ExcludeReplica)
+        {
+            continue;
+        }
+
+        const FString& EndpointKey = State.EndpointKeys[Replica];
+        const FEndpointState* Endpoint = Endpoints.Find(EndpointKey);
+        const bool bHalfOpen = Endpoint && Endpoint->State == EFusionCircuitState::HalfOpen;
+        if ((Endpoint && Endpoint->State == EFusionCircuitState::Open) || (bHalfOpen && Endpoint->bProbeInFlight))
+        {
+            continue;
+        }
+        if (InFlightPerEndpoint.FindRef(EndpointKey) >= MaxConcurrentPerEndpoint)
+        {
+            continue;
+        }
+
+        const bool bClosed = !bHalfOpen;
+        const int32 Failures = Endpoint ? Endpoint->ConsecutiveFailures : 0;
+        const float Latency = Endpoint ? GetLatencyPercentile(*Endpoint, 0.5f) : 0.f;
+
+        bool bBetter = BestReplica == INDEX_NONE;
+        if (!bBetter && bClosed != bBestClosed)
+        {
+            bBetter = bClosed;
+        }
+        else if (!bBetter && Failures != BestFailures)
+        {
+            bBetter = Failures < BestFailures;
+        }
+        else if (!bBetter)
+        {
+            bBetter = Latency < BestLatency;
+        }
+
+        if (bBetter)
+        {
+            BestReplica = Replica;
+            BestFailures = Failures;
+            BestLatency = Latency;
+            bBestClosed = bClosed;
+        }
+    }
+    return BestReplica;
+}
+
+bool FFusionRequestScheduler::AreAllReplicasOpen(const FJobState& State) const
+{
+    for (const FString& EndpointKey : State.EndpointKeys)
+    {
+        const FEndpointState* Endpoint = Endpoints.Find(EndpointKey);
+        if (!Endpoint || Endpoint->State != EFusionCircuitState::Open)
+        {
+            return false;
+        }
+    }
+    return State.EndpointKeys.Num() > 0;
+}
+
+void FFusionRequestScheduler::Dispatch(const TSharedPtr<FJobState>& State, int32 ReplicaIndex)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    FClassCounters& ClassCounters = GetCounters(State->Job.Priority);
+    const double WaitSeconds = Now - (State->Attempt > 0 ? State->NotBefore : State->EnqueueTime);
+    ++ClassCounters.Stats.Dispatched;
+    ClassCounters.TotalWaitSeconds += WaitSeconds;
+    ClassCounters.Stats.MaxWaitSeconds = FMath::Max(ClassCounters.Stats.MaxWaitSeconds, static_cast<float>(WaitSeconds));
+
+    InFlight.Add(State->Id, State);
+    StartAttempt(State, ReplicaIndex, false);
+}
+
+void FFusionRequestScheduler::StartAttempt(const TSharedPtr<FJobState>& State, int32 ReplicaIndex, bool bIsHedge)
+{
+    FAttempt& Attempt = State->Attempts.AddDefaulted_GetRef();
+    Attempt.Id = NextAttemptId++;
+    Attempt.ReplicaIndex = ReplicaIndex;
+    Attempt.DispatchTime = FPlatformTime::Seconds();
+    Attempt.bIsHedge = bIsHedge;
+
+    const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+    Request->SetURL(State->Urls[ReplicaIndex]);
+    if (State->Job.ConfigureRequest)
+    {
+        State->Job.ConfigureRequest(Request);
+    }
+
+    if (State->Job.DeadlineSeconds > 0.f)
+    {
+        const float Remaining = State->Job.DeadlineSeconds - static_cast<float>(Attempt.DispatchTime - State->EnqueueTime);
+        Request->SetTimeout(FMath::Max(0.1f, Remaining));
+    }
+
+    const uint64 JobId = State->Id;
+    const uint64 AttemptId = Attempt.Id;
+    TWeakPtr<FFusionRequestScheduler> WeakScheduler = AsShared();
+    Request->OnProcessRequestComplete().BindLambda([WeakScheduler, JobId, AttemptId](FHttpRequestPtr, FHttpResponsePtr Response, bool bWasSuccessful)
+    {
+        if (const TSharedPtr<FFusionRequestScheduler> Scheduler = WeakScheduler.Pin())
+        {
+            Scheduler->HandleRequestComplete(JobId, AttemptId, Response, bWasSuccessful);
+        }
+    });
+
+    const FString& EndpointKey = State->EndpointKeys[ReplicaIndex];
+    FEndpointState& Endpoint = Endpoints.FindOrAdd(EndpointKey);
+    if (Endpoint.State == EFusionCircuitState::HalfOpen)
+    {
+        Attempt.bIsProbe = true;
+        Endpoint.bProbeInFlight = true;
+    }
+
+    // A hedge starts its own clock; a retry waits from the end of its backoff, like the dispatch wait stats.
+    const double QueuedTime = bIsHedge ? 0.0 : (State->Attempt > 0 ? State->NotBefore : State->EnqueueTime);
+    Attempt.Timing = FFusionRequestTelemetry::Track(Request, QueuedTime);
+    Attempt.Request = Request;
+    ++InFlightPerEndpoint.FindOrAdd(EndpointKey);
+
+    Request->ProcessRequest();
+}
+
+void FFusionRequestScheduler::TryHedge(const TSharedPtr<FJobState>& State, double Now)
+{
+    if (State->Job.HedgePercentile <= 0.f || State->bHedged || State->Attempts.Num() != 1 || State->Urls.Num() < 2)
+    {
+        return;
+    }
+
+    // The delay follows the replica that is being waited on, so a slow replica is hedged sooner relative to its norm.
+    const FAttempt& Primary = State->Attempts[0];
+    const FEndpointState* Endpoint = Endpoints.Find(State->EndpointKeys[Primary.ReplicaIndex]);
+    float HedgeDelay = HedgingSettings.FallbackDelaySeconds;
+    if (Endpoint && Endpoint->LatencySamples.Num() >= FMath::Max(1, HedgingSettings.MinSamples))
+    {
+        HedgeDelay = GetLatencyPercentile(*Endpoint, State->Job.HedgePercentile);
+    }
+    else if (HedgeDelay <= 0.f)
+    {
+        return;
+    }
+
+    if (Now - Primary.DispatchTime < FMath::Max(HedgingSettings.MinDelaySeconds, HedgeDelay))
+    {
+        return;
+    }
+
+    const int32 Replica = PickReplica(*State, Primary.ReplicaIndex);
+    if (Replica == INDEX_NONE)
+    {
+        return;
+    }
+
+    UE_LOG(LogFusionRequestScheduler, Verbose, TEXT("Hedging '%s' to %s after %.3fs"), *State->Job.Key, *State->Urls[Replica], Now - Primary.DispatchTime);
+    State->bHedged = true;
+    ++GetCounters(State->Job.Priority).Stats.Hedged;
+    ++Endpoints.FindOrAdd(State->EndpointKeys[Replica]).Health.HedgesSent;
+    StartAttempt(State, Replica, true);
+}
+
+void FFusionRequestScheduler::HandleRequestComplete(uint64 JobId, uint64 AttemptId, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+    const TSharedPtr<FJobState> State = InFlight.FindRef(JobId);
+    if (!State.IsValid())
+    {
+        // Already finished through cancellation or expiry.
+        return;
+    }
+
+    const int32 AttemptIndex = State->Attempts.IndexOfByPredicate([AttemptId](const FAttempt& Attempt) { return Attempt.Id == AttemptId; });
+    if (AttemptIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    const FAttempt Attempt = State->Attempts[AttemptIndex];
+    State->Attempts.RemoveAt(AttemptIndex);
+    ReleaseAttempt(*State, Attempt);
+    FFusionRequestTelemetry::Get().RecordCompleted(*Attempt.Timing, Response);
+
+    const double Now = FPlatformTime::Seconds();
+    const bool bTransportFailed = !bWasSuccessful || !Response.IsValid();
+    const int32 StatusCode = bTransportFailed ? 0 : Response->GetResponseCode();
+    const bool bServerFailed = StatusCode >= 500 || StatusCode == EHttpResponseCodes::TooManyRequests;
+    const bool bHealthy = !bTransportFailed && !bServerFailed;
+
+    // 4xx answers mean the backend is up; only transport failures and server errors count against the breaker.
+    const FString& EndpointKey = State->EndpointKeys[Attempt.ReplicaIndex];
+    RecordEndpointResult(EndpointKey, bHealthy);
+
+    if (bHealthy)
+    {
+        RecordLatency(EndpointKey, static_cast<float>(Now - Attempt.DispatchTime));
+        if (Attempt.bIsHedge)
+        {
+            ++Endpoints.FindOrAdd(EndpointKey).Health.HedgeWins;
+        }
+    }
+    else if (State->Attempts.Num() > 0)
+    {
+        // The other half of a hedged pair may still answer.
+        Pump();
+        return;
+    }
+
+    if (!bHealthy && TryScheduleRetry(State, Now))
+    {
+        Pump();
+        return;
+    }
+
+    EFusionRequestOutcome Outcome = EFusionRequestOutcome::Succeeded;
+    if (bTransportFailed)
+    {
+        // A request that ran into its SetTimeout budget reports as a plain failure.
+        Outcome = IsExpired(*State, Now) ? EFusionRequestOutcome::Expired : EFusionRequestOutcome::Failed;
+    }
+    else if (!EHttpResponseCodes::IsOk(StatusCode))
+    {
+        // Retries are used up or the error is not retryable; the response still goes along for its status code.
+        Outcome = EFusionRequestOutcome::Failed;
+    }
+
+    Finish(State, Response, Outcome);
+    Pump();
+}
+
+void FFusionRequestScheduler::Finish(const TSharedPtr<FJobState>& State, FHttpResponsePtr Response, EFusionRequestOutcome Outcome)
+{
+    if (InFlight.Remove(State->Id) > 0)
+    {
+        // Cancels the losing half of a hedged pair as well as cancelled and expired requests.
+        CancelAttempts(*State);
+    }
+    else
+    {
+        Queue.Remove(State);
+    }
+
+    FFusionRequestClassStats& Stats = GetCounters(State->Job.Priority).Stats;
+    switch (Outcome)
+    {
+    case EFusionRequestOutcome::Succeeded:
+        ++Stats.Succeeded;
+        break;
+    case EFusionRequestOutcome::Failed:
+        ++Stats.Failed;
+        break;
+    case EFusionRequestOutcome::Cancelled:
+        ++Stats.Cancelled;
+        break;
+    case EFusionRequestOutcome::Expired:
+        ++Stats.Expired;
+        break;
+    case EFusionRequestOutcome::Rejected:
+        ++Stats.Rejected;
+        for (const FString& EndpointKey : State->EndpointKeys)
+        {
+            ++Endpoints.FindOrAdd(EndpointKey).Health.Rejected;
+        }
+        break;
+    }
+
+    if (State->Job.OnComplete)
+    {
+        TFunction<void(FHttpResponsePtr, EFusionRequestOutcome)> OnComplete = MoveTemp(State->Job.OnComplete);
+        OnComplete(Response, Outcome);
+    }
+}
+
+void FFusionRequestScheduler::CancelAttempts(FJobState& State)
+{
+    TArray<FAttempt> Attempts = MoveTemp(State.Attempts);
+    State.Attempts.Reset();
+    for (const FAttempt& Attempt : Attempts)
+    {
+        ReleaseAttempt(State, Attempt);
+        FFusionRequestTelemetry::Get().RecordAbandoned(*Attempt.Timing);
+        Attempt.Request->OnProcessRequestComplete().Unbind();
+        Attempt.Request->CancelRequest();
+    }
+}
+
+void FFusionRequestScheduler::ReleaseAttempt(const FJobState& State, const FAttempt& Attempt)
+{
+    const FString& EndpointKey = State.EndpointKeys[Attempt.ReplicaIndex];
+    int32& EndpointCount = InFlightPerEndpoint.FindOrAdd(EndpointKey);
+    EndpointCount = FMath::Max(0, EndpointCount - 1);
+
+    if (Attempt.bIsProbe)
+    {
+        if (FEndpointState* Endpoint = Endpoints.Find(EndpointKey))
+        {
+            Endpoint->bProbeInFlight = false;
+        }
+    }
+}
+
+void FFusionRequestScheduler::RecordLatency(const FString& EndpointKey, float Seconds)
+{
+    FEndpointState& Endpoint = Endpoints.FindOrAdd(EndpointKey);
+    if (Endpoint.LatencySamples.Num() < MaxLatencySamples)
+    {
+        Endpoint.LatencySamples.Add(Seconds);
+    }
+    else
+    {
+        const float Evicted = Endpoint.LatencySamples[Endpoint.NextLatencySample];
+        Endpoint.SortedLatencySamples.RemoveAt(Algo::LowerBound(Endpoint.SortedLatencySamples, Evicted), EAllowShrinking::No);
+        Endpoint.LatencySamples[Endpoint.NextLatencySample] = Seconds;
+    }
+    Endpoint.SortedLatencySamples.Insert(Seconds, Algo::UpperBound(Endpoint.SortedLatencySamples, Seconds));
+    Endpoint.NextLatencySample = (Endpoint.NextLatencySample + 1) % MaxLatencySamples;
+}
+
+bool FFusionRequestScheduler::TryScheduleRetry(const TSharedPtr<FJobState>& State, double Now)
+{
+    if (State->Attempt >= State->Job.MaxRetries)
+    {
+        return false;
+    }
+
+    // Full jitter keeps clients that failed together from retrying in lockstep.
+    const float MaxDelay = State->Job.RetryBaseDelaySeconds * FMath::Pow(2.f, static_cast<float>(State->Attempt));
+    const double Delay = FMath::FRandRange(0.f, MaxDelay);
+    if (State->Job.DeadlineSeconds > 0.f && Now + Delay - State->EnqueueTime >= State->Job.DeadlineSeconds)
+    {
+        return false;
+    }
+
+    InFlight.Remove(State->Id);
+    CancelAttempts(*State);
+    State->bHedged = false;
+    State->NotBefore = Now + Delay;
+    ++State->Attempt;
+    ++GetCounters(State->Job.Priority).Stats.Retried;
+
+    UE_LOG(LogFusionRequestScheduler, Log, TEXT("Retrying '%s' (attempt %d) in %.2fs"), *State->Job.Key, State->Attempt + 1, Delay);
+    Queue.Add(State);
+    return true;
+}
+
+void FFusionRequestScheduler::RecordEndpointResult(const FString& EndpointKey, bool bHealthy)
+{
+    FEndpointState& Endpoint = Endpoints.FindOrAdd(EndpointKey);
+    const double Now = FPlatformTime::Seconds();
+
+    if (bHealthy)
+    {
+        Endpoint.ConsecutiveFailures = 0;
+        if (Endpoint.State != EFusionCircuitState::Closed)
+        {
+            SetCircuitState(EndpointKey, Endpoint, EFusionCircuitState::Closed, Now);
+        }
+        return;
+    }
+
+    ++Endpoint.ConsecutiveFailures;
+    const bool bTripped = BreakerSettings.FailureThreshold > 0 && Endpoint.ConsecutiveFailures >= BreakerSettings.FailureThreshold;
+    if (Endpoint.State == EFusionCircuitState::HalfOpen || (Endpoint.State == EFusionCircuitState::Closed && bTripped))
+    {
+        SetCircuitState(EndpointKey, Endpoint, EFusionCircuitState::Open, Now);
+    }
+}
+
+void FFusionRequestScheduler::UpdateCircuit(const FString& EndpointKey, FEndpointState& Endpoint, double Now)
+{
+    if (Endpoint.State == EFusionCircuitState::Open && Now - Endpoint.OpenedAt >= BreakerSettings.OpenSeconds)
+    {
+        SetCircuitState(EndpointKey, Endpoint, EFusionCircuitState::HalfOpen, Now);
+    }
+}
+
+void FFusionRequestScheduler::SetCircuitState(const FString& EndpointKey, FEndpointState& Endpoint, EFusionCircuitState NewState, double Now)
+{
+    Endpoint.State = NewState;
+    switch (NewState)
+    {
+    case EFusionCircuitState::Open:
+        Endpoint.OpenedAt = Now;
+        ++Endpoint.Health.TimesOpened;
+        UE_LOG(LogFusionRequestScheduler, Warning, TEXT("Circuit open for %s after %d consecutive failures"), *EndpointKey, Endpoint.ConsecutiveFailures);
+        break;
+    case EFusionCircuitState::HalfOpen:
+        ++Endpoint.Health.TimesHalfOpened;
+        UE_LOG(LogFusionRequestScheduler, Log, TEXT("Circuit half-open for %s; sending a probe"), *EndpointKey);
+        break;
+    case EFusionCircuitState::Closed:
+        UE_LOG(LogFusionRequestScheduler, Log, TEXT("Circuit closed for %s"), *EndpointKey);
+        break;
+    }
+
+    if (OnCircuitStateChanged)
+    {
+        OnCircuitStateChanged(EndpointKey, NewState);
+    }
+}
+
+bool FFusionRequestScheduler::IsExpired(const FJobState& State, double Now) const
+{
+    return State.Job.DeadlineSeconds > 0.f && Now - State.EnqueueTime > State.Job.DeadlineSeconds;
+}
+
+FFusionRequestScheduler::FClassCounters& FFusionRequestScheduler::GetCounters(EFusionRequestPriority Priority)
+{
+    return Counters[FMath::Clamp(static_cast<int32>(Priority), 0, static_cast<int32>(UE_ARRAY_COUNT(Counters)) - 1)];
+}
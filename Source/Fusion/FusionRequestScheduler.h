@@ -0,0 +1,355 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "FusionRequestTelemetry.h"
+#include "FusionRequestScheduler.generated.h"
+
+/** Priority classes for outgoing AI requests; lower values are dispatched first. */
+UENUM(BlueprintType)
+enum class EFusionRequestPriority : uint8
+{
+    Voice,
+    Description,
+    Speculative
+};
+
+/** How a scheduled request finished. */
+UENUM(BlueprintType)
+enum class EFusionRequestOutcome : uint8
+{
+    Succeeded,
+    Failed,
+    Cancelled,
+    Expired,
+    /** Failed fast because the endpoint's circuit breaker is open. */
+    Rejected
+};
+
+/** Circuit breaker state of one endpoint. */
+UENUM(BlueprintType)
+enum class EFusionCircuitState : uint8
+{
+    /** Requests flow normally. */
+    Closed,
+    /** Too many consecutive failures; requests are rejected without touching the network. */
+    Open,
+    /** Cool-down elapsed; a single probe request decides whether to close or reopen. */
+    HalfOpen
+};
+
+USTRUCT(BlueprintType)
+struct FFusionRequestClassStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 QueueDepth = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 InFlight = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 Dispatched = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 Succeeded = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 Failed = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 Cancelled = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 Expired = 0;
+
+    /** Attempts scheduled again after a failed try. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 Retried = 0;
+
+    /** Jobs failed fast by an open circuit breaker. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 Rejected = 0;
+
+    /** Duplicate requests sent to a second replica because the first was slow. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 Hedged = 0;
+
+    /** Mean time between enqueue and dispatch. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    float AverageWaitSeconds = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    float MaxWaitSeconds = 0.f;
+};
+
+USTRUCT(BlueprintType)
+struct FFusionEndpointHealth
+{
+    GENERATED_BODY()
+
+    /** Request URL without its query string. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    FString Endpoint;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    EFusionCircuitState State = EFusionCircuitState::Closed;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 ConsecutiveFailures = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 TimesOpened = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 TimesHalfOpened = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 Rejected = 0;
+
+    /** Seconds until an open breaker lets a probe through; 0 otherwise. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    float SecondsUntilProbe = 0.f;
+
+    /** Latency percentiles over the most recent successful responses. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    float LatencyP50Seconds = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    float LatencyP95Seconds = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 LatencySamples = 0;
+
+    /** Hedge duplicates sent to this replica, and how many of them answered first. */
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 HedgesSent = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    int32 HedgeWins = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FFusionRequestSchedulerStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    FFusionRequestClassStats Voice;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    FFusionRequestClassStats Description;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    FFusionRequestClassStats Speculative;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Fusion|Networking")
+    TArray<FFusionEndpointHealth> Endpoints;
+};
+
+/** A unit of work for FFusionRequestScheduler. The request object itself is only created at dispatch time. */
+struct FFusionRequestJob
+{
+    /** Cancellation key; at most one job per key is pending at a time. */
+    FString Key;
+
+    FString Url;
+
+    /** Further replicas serving the same API as Url; every attempt goes to the healthiest, fastest one with a free slot. */
+    TArray<FString> ReplicaUrls;
+
+    /**
+     * Groups Url with other jobs for the concurrency cap, circuit breaker and latency stats. Defaults to Url without
+     * its query; set it when every job has its own URL, such as one file per request on the same server.
+     */
+    FString EndpointKey;
+
+    EFusionRequestPriority Priority = EFusionRequestPriority::Description;
+
+    /** Total budget from enqueue to completion in seconds; 0 disables the deadline. */
+    float DeadlineSeconds = 0.f;
+
+    /** When true a job with the same key replaces (cancels) the pending one, otherwise the new job is dropped. */
+    bool bSupersedeExisting = false;
+
+    /** Extra attempts after a connection failure, 5xx or 429. Only set this for idempotent requests. */
+    int32 MaxRetries = 0;
+
+    /** Backoff before retry N is drawn uniformly from [0, RetryBaseDelaySeconds * 2^N] ("full jitter"). */
+    float RetryBaseDelaySeconds = 0.25f;
+
+    /**
+     * Sends a duplicate to another replica once the first attempt has been out longer than this percentile (0-1) of
+     * that replica's observed latency; the first answer wins and the other is cancelled. 0 disables hedging.
+     * Only for idempotent requests whose ConfigureRequest does not bind a shared streaming body.
+     */
+    float HedgePercentile = 0.f;
+
+    /** Sets verb, headers and body on the freshly created request. The progress delegate is reserved for timing telemetry. */
+    TFunction<void(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>&)> ConfigureRequest;
+
+    /** Invoked exactly once on the game thread. A non-2xx answer is Failed but still passes its response along. */
+    TFunction<void(FHttpResponsePtr Response, EFusionRequestOutcome Outcome)> OnComplete;
+};
+
+/** Consecutive failures that open an endpoint's breaker, and how long it stays open before probing. */
+struct FFusionCircuitBreakerSettings
+{
+    int32 FailureThreshold = 5;
+    float OpenSeconds = 10.f;
+};
+
+/** Bounds for the hedge delay derived from replica latency. */
+struct FFusionHedgingSettings
+{
+    /** Never hedge sooner than this, however fast the replica usually is. */
+    float MinDelaySeconds = 0.05f;
+
+    /** Hedge delay while a replica has fewer than MinSamples latency samples (0 = do not hedge until measured). */
+    float FallbackDelaySeconds = 0.5f;
+
+    int32 MinSamples = 8;
+};
+
+/**
+ * Game-thread HTTP scheduler used by AFusionMode. Jobs wait in a priority queue until their endpoint has a free
+ * concurrency slot, can be cancelled by key, and are expired once their deadline passes (queued or in flight).
+ * Failed idempotent jobs are retried with jittered backoff inside their deadline, and a per-endpoint circuit
+ * breaker rejects jobs outright while the endpoint keeps failing. Jobs may list replicas, which are chosen per attempt
+ * by health and latency and used for hedged duplicates. Every attempt reports its phase timings to FFusionRequestTelemetry.
+ */
+class FUSION_API FFusionRequestScheduler : public TSharedFromThis<FFusionRequestScheduler>
+{
+public:
+    explicit FFusionRequestScheduler(int32 InMaxConcurrentPerEndpoint);
+
+    /** Queues a job and dispatches immediately if a slot is free. Returns false if an existing job with the same key was kept instead. */
+    bool Enqueue(FFusionRequestJob&& Job);
+
+    /** Moves a queued job to a more urgent priority class. Returns false if it is in flight or already that urgent. */
+    bool Promote(const FString& Key, EFusionRequestPriority Priority);
+
+    /** Cancels the queued or in-flight job registered under Key. */
+    bool Cancel(const FString& Key);
+
+    /** Cancels every pending job of the given priority class, optionally only those whose key starts with KeyPrefix. */
+    int32 CancelPriority(EFusionRequestPriority Priority, const FString& KeyPrefix = FString());
+
+    void CancelAll();
+
+    bool IsPending(const FString& Key) const;
+
+    /** Expires overdue jobs and fills free slots; call periodically. */
+    void Tick();
+
+    void SetMaxConcurrentPerEndpoint(int32 InMaxConcurrentPerEndpoint);
+
+    void SetCircuitBreakerSettings(const FFusionCircuitBreakerSettings& InSettings);
+
+    void SetHedgingSettings(const FFusionHedgingSettings& InSettings);
+
+    /** Current breaker state for the endpoint serving Url. */
+    EFusionCircuitState GetCircuitState(const FString& Url) const;
+
+    /** Called on every breaker transition with the endpoint key (URL without query). */
+    TFunction<void(const FString& Endpoint, EFusionCircuitState State)> OnCircuitStateChanged;
+
+    FFusionRequestSchedulerStats GetStats() const;
+
+private:
+    /** One HTTP request sent for a job; a hedged job has two in flight. */
+    struct FAttempt
+    {
+        uint64 Id = 0;
+        int32 ReplicaIndex = 0;
+        double DispatchTime = 0.0;
+        TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request;
+        TSharedPtr<FFusionRequestTiming> Timing;
+
+        /** Dispatched as the single half-open probe of its endpoint. */
+        bool bIsProbe = false;
+        bool bIsHedge = false;
+    };
+
+    struct FJobState
+    {
+        uint64 Id = 0;
+        FFusionRequestJob Job;
+
+        /** Job.Url followed by Job.ReplicaUrls, and their endpoint keys. */
+        TArray<FString> Urls;
+        TArray<FString> EndpointKeys;
+
+        double EnqueueTime = 0.0;
+
+        /** Retry count; each retry starts a new round of attempts. */
+        int32 Attempt = 0;
+
+        /** Retry backoff: not dispatched before this time. */
+        double NotBefore = 0.0;
+
+        TArray<FAttempt> Attempts;
+        bool bHedged = false;
+    };
+
+    struct FEndpointState
+    {
+        EFusionCircuitState State = EFusionCircuitState::Closed;
+        int32 ConsecutiveFailures = 0;
+        double OpenedAt = 0.0;
+        bool bProbeInFlight = false;
+        FFusionEndpointHealth Health;
+
+        /** Ring buffer of recent successful response times. */
+        TArray<float> LatencySamples;
+        int32 NextLatencySample = 0;
+
+        /** The same samples kept in ascending order, so percentiles are a lookup on every pump. */
+        TArray<float> SortedLatencySamples;
+    };
+
+    struct FClassCounters
+    {
+        FFusionRequestClassStats Stats;
+        double TotalWaitSeconds = 0.0;
+    };
+
+    static FString MakeEndpointKey(const FString& Url);
+
+    static float GetLatencyPercentile(const FEndpointState& Endpoint, float Percentile);
+
+    TSharedPtr<FJobState> FindPending(const FString& Key) const;
+    void Pump();
+    void Dispatch(const TSharedPtr<FJobState>& State, int32 ReplicaIndex);
+    void StartAttempt(const TSharedPtr<FJobState>& State, int32 ReplicaIndex, bool bIsHedge);
+    void TryHedge(const TSharedPtr<FJobState>& State, double Now);
+    int32 PickReplica(const FJobState& State, int32 ExcludeReplica) const;
+    bool AreAllReplicasOpen(const FJobState& State) const;
+    void HandleRequestComplete(uint64 JobId, uint64 AttemptId, FHttpResponsePtr Response, bool bWasSuccessful);
+    void Finish(const TSharedPtr<FJobState>& State, FHttpResponsePtr Response, EFusionRequestOutcome Outcome);
+    void CancelAttempts(FJobState& State);
+    void ReleaseAttempt(const FJobState& State, const FAttempt& Attempt);
+    void RecordLatency(const FString& EndpointKey, float Seconds);
+    bool IsExpired(const FJobState& State, double Now) const;
+    bool TryScheduleRetry(const TSharedPtr<FJobState>& State, double Now);
+    void RecordEndpointResult(const FString& EndpointKey, bool bHealthy);
+    void UpdateCircuit(const FString& EndpointKey, FEndpointState& Endpoint, double Now);
+    void SetCircuitState(const FString& EndpointKey, FEndpointState& Endpoint, EFusionCircuitState NewState, double Now);
+    FClassCounters& GetCounters(EFusionRequestPriority Priority);
+
+    int32 MaxConcurrentPerEndpoint;
+    uint64 NextJobId = 1;
+    uint64 NextAttemptId = 1;
+
+    /** Kept in enqueue order; dispatch picks the best priority whose endpoint has capacity. */
+    TArray<TSharedPtr<FJobState>> Queue;
+    TMap<uint64, TSharedPtr<FJobState>> InFlight;
+    TMap<FString, int32> InFlightPerEndpoint;
+    TMap<FString, FEndpointState> Endpoints;
+    FFusionCircuitBreakerSettings BreakerSettings;
+    FFusionHedgingSettings HedgingSettings;
+
+    FClassCounters Counters[3];
+};
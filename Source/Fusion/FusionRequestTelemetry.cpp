@@ -0,0 +1,274 @@
+#include "FusionRequestTelemetry.h"
+
+#include "FusionDebugOverlay.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFusionRequestTelemetry, Log, All);
+
+namespace
+{
+    constexpr FFusionDebugOverlay TimingOverlay(0x46524551);
+
+    TAutoConsoleVariable<bool> CVarTimingOverlay(
+        TEXT("Fusion.Net.TimingOverlay"),
+        false,
+        TEXT("Shows p50/p95 of queue, upload, server, download and total time per AI endpoint on screen."));
+
+    double PhaseSeconds(double From, double To)
+    {
+        return From > 0.0 && To >= From ? To - From : -1.0;
+    }
+}
+
+void FFusionLatencyHistogram::Add(double Seconds)
+{
+    int32 Bucket = 0;
+    while (Bucket < NumBuckets - 1 && Seconds > GetBucketUpperBound(Bucket))
+    {
+        ++Bucket;
+    }
+
+    ++Buckets[Bucket];
+    ++Count;
+    SumSeconds += Seconds;
+    MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+}
+
+double FFusionLatencyHistogram::GetPercentile(double Percentile) const
+{
+    if (Count == 0)
+    {
+        return 0.0;
+    }
+
+    const uint32 Rank = FMath::Max(1u, static_cast<uint32>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 1.0) * Count)));
+    uint32 Seen = 0;
+    for (int32 Bucket = 0; Bucket < NumBuckets - 1; ++Bucket)
+    {
+        Seen += Buckets[Bucket];
+        if (Seen >= Rank)
+        {
+            return FMath::Min(GetBucketUpperBound(Bucket), MaxSeconds);
+        }
+    }
+    return MaxSeconds;
+}
+
+double FFusionLatencyHistogram::GetBucketUpperBound(int32 Bucket)
+{
+    return Bucket < NumBuckets - 1 ? 0.001 * static_cast<double>(1u << Bucket) : TNumericLimits<double>::Max();
+}
+
+FFusionRequestTelemetry& FFusionRequestTelemetry::Get()
+{
+    static FFusionRequestTelemetry Instance;
+    return Instance;
+}
+
+FString FFusionRequestTelemetry::MakeEndpointKey(const FString& Url)
+{
+    int32 QueryIndex = INDEX_NONE;
+    if (Url.FindChar(TEXT('?'), QueryIndex))
+    {
+        return Url.Left(QueryIndex);
+    }
+    return Url;
+}
+
+const TCHAR* FFusionRequestTelemetry::GetPhaseName(EFusionRequestPhase Phase)
+{
+    switch (Phase)
+    {
+    case EFusionRequestPhase::Queue:
+        return TEXT("queue");
+    case EFusionRequestPhase::Upload:
+        return TEXT("upload");
+    case EFusionRequestPhase::Server:
+        return TEXT("server");
+    case EFusionRequestPhase::Download:
+        return TEXT("download");
+    case EFusionRequestPhase::Total:
+        return TEXT("total");
+    default:
+        return TEXT("unknown");
+    }
+}
+
+TSharedRef<FFusionRequestTiming> FFusionRequestTelemetry::Track(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, double QueuedTime)
+{
+    const TSharedRef<FFusionRequestTiming> Timing = MakeShared<FFusionRequestTiming>();
+    Timing->Endpoint = MakeEndpointKey(Request->GetURL());
+    Timing->SendStartTime = FPlatformTime::Seconds();
+    Timing->QueuedTime = QueuedTime > 0.0 ? QueuedTime : Timing->SendStartTime;
+
+    // Progress is reported on the game thread, at most once per HTTP tick, so each stamp is accurate to about a frame.
+    const uint64 ContentLength = Request->GetContentLength();
+    Request->OnRequestProgress64().BindLambda([Timing, ContentLength](FHttpRequestPtr, uint64 BytesSent, uint64 BytesReceived)
+    {
+        const double Now = FPlatformTime::Seconds();
+        Timing->BytesSent = BytesSent;
+        Timing->BytesReceived = BytesReceived;
+
+        if (Timing->UploadCompleteTime == 0.0 && (BytesSent >= ContentLength || BytesReceived > 0))
+        {
+            Timing->UploadCompleteTime = Now;
+        }
+        if (Timing->FirstByteTime == 0.0 && BytesReceived > 0)
+        {
+            Timing->FirstByteTime = Now;
+        }
+    });
+
+    return Timing;
+}
+
+void FFusionRequestTelemetry::RecordCompleted(FFusionRequestTiming& Timing, const FHttpResponsePtr& Response)
+{
+    Timing.CompleteTime = FPlatformTime::Seconds();
+    FEndpointTimings& Endpoint = Endpoints.FindOrAdd(Timing.Endpoint);
+
+    if (!Response.IsValid() || Response->GetResponseCode() <= 0)
+    {
+        ++Endpoint.TransportFailures;
+        return;
+    }
+
+    // Small responses can finish between two progress reports; the missing stamps collapse onto the next one seen.
+    if (Timing.FirstByteTime == 0.0)
+    {
+        Timing.FirstByteTime = Timing.CompleteTime;
+    }
+    if (Timing.UploadCompleteTime == 0.0)
+    {
+        Timing.UploadCompleteTime = Timing.FirstByteTime;
+    }
+
+    ++Endpoint.Completed;
+    if (Response->GetResponseCode() >= 400)
+    {
+        ++Endpoint.HttpErrors;
+    }
+
+    const double Phases[] =
+    {
+        PhaseSeconds(Timing.QueuedTime, Timing.SendStartTime),
+        PhaseSeconds(Timing.SendStartTime, Timing.UploadCompleteTime),
+        PhaseSeconds(Timing.UploadCompleteTime, Timing.FirstByteTime),
+        PhaseSeconds(Timing.FirstByteTime, Timing.CompleteTime),
+        PhaseSeconds(Timing.QueuedTime, Timing.CompleteTime),
+    };
+    static_assert(UE_ARRAY_COUNT(Phases) == static_cast<int32>(EFusionRequestPhase::Num), "One duration per phase");
+
+    for (int32 Phase = 0; Phase < static_cast<int32>(EFusionRequestPhase::Num); ++Phase)
+    {
+        if (Phases[Phase] >= 0.0)
+        {
+            Endpoint.Phases[Phase].Add(Phases[Phase]);
+        }
+    }
+
+    UE_LOG(LogFusionRequestTelemetry, Verbose, TEXT("%s: queue %.3fs, upload %.3fs, server %.3fs, download %.3fs (%llu bytes up, %llu down)"),
+        *Timing.Endpoint, Phases[0], Phases[1], Phases[2], Phases[3], Timing.BytesSent, Timing.BytesReceived);
+}
+
+void FFusionRequestTelemetry::RecordAbandoned(const FFusionRequestTiming& Timing)
+{
+    ++Endpoints.FindOrAdd(Timing.Endpoint).Abandoned;
+}
+
+bool FFusionRequestTelemetry::DumpCsv(const FString& FilePath) const
+{
+    FString Csv = TEXT("endpoint,phase,count,completed,http_errors,transport_failures,abandoned,mean_ms,p50_ms,p90_ms,p95_ms,p99_ms,max_ms");
+    for (int32 Bucket = 0; Bucket < FFusionLatencyHistogram::NumBuckets; ++Bucket)
+    {
+        Csv += Bucket < FFusionLatencyHistogram::NumBuckets - 1
+            ? FString::Printf(TEXT(",le_%.0f_ms"), FFusionLatencyHistogram::GetBucketUpperBound(Bucket) * 1000.0)
+            : FString(TEXT(",inf_ms"));
+    }
+    Csv += LINE_TERMINATOR;
+
+    for (const TPair<FString, FEndpointTimings>& Pair : Endpoints)
+    {
+        const FEndpointTimings& Endpoint = Pair.Value;
+        for (int32 Phase = 0; Phase < static_cast<int32>(EFusionRequestPhase::Num); ++Phase)
+        {
+            const FFusionLatencyHistogram& Histogram = Endpoint.Phases[Phase];
+            Csv += FString::Printf(TEXT("\"%s\",%s,%u,%u,%u,%u,%u,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f"),
+                *Pair.Key.Replace(TEXT("\""), TEXT("\"\"")), GetPhaseName(static_cast<EFusionRequestPhase>(Phase)),
+                Histogram.Count, Endpoint.Completed, Endpoint.HttpErrors, Endpoint.TransportFailures, Endpoint.Abandoned,
+                Histogram.GetMean() * 1000.0, Histogram.GetPercentile(0.5) * 1000.0, Histogram.GetPercentile(0.9) * 1000.0,
+                Histogram.GetPercentile(0.95) * 1000.0, Histogram.GetPercentile(0.99) * 1000.0, Histogram.MaxSeconds * 1000.0);
+            for (const uint32 BucketCount : Histogram.Buckets)
+            {
+                Csv += FString::Printf(TEXT(",%u"), BucketCount);
+            }
+            Csv += LINE_TERMINATOR;
+        }
+    }
+
+    const FString ResolvedPath = FPaths::IsRelative(FilePath) ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"), FilePath) : FilePath;
+    if (!FFileHelper::SaveStringToFile(Csv, *ResolvedPath))
+    {
+        UE_LOG(LogFusionRequestTelemetry, Error, TEXT("Failed to write request timings to %s"), *ResolvedPath);
+        return false;
+    }
+
+    UE_LOG(LogFusionRequestTelemetry, Display, TEXT("Wrote request timings for %d endpoints to %s"), Endpoints.Num(), *ResolvedPath);
+    return true;
+}
+
+void FFusionRequestTelemetry::UpdateDebugOverlay()
+{
+    const double Now = FPlatformTime::Seconds();
+    if (!CVarTimingOverlay.GetValueOnGameThread() || !FFusionDebugOverlay::ShouldUpdate(Now, LastOverlayUpdate))
+    {
+        return;
+    }
+
+    int32 Line = 0;
+    for (const TPair<FString, FEndpointTimings>& Pair : Endpoints)
+    {
+        if (Line == FFusionDebugOverlay::MaxLines)
+        {
+            break;
+        }
+
+        const FEndpointTimings& Endpoint = Pair.Value;
+        FString Message = FString::Printf(TEXT("%s  n=%u err=%u fail=%u |"), *Pair.Key, Endpoint.Completed, Endpoint.HttpErrors, Endpoint.TransportFailures);
+        for (int32 Phase = 0; Phase < static_cast<int32>(EFusionRequestPhase::Num); ++Phase)
+        {
+            const FFusionLatencyHistogram& Histogram = Endpoint.Phases[Phase];
+            Message += FString::Printf(TEXT(" %s %.0f/%.0fms"), GetPhaseName(static_cast<EFusionRequestPhase>(Phase)),
+                Histogram.GetPercentile(0.5) * 1000.0, Histogram.GetPercentile(0.95) * 1000.0);
+        }
+
+        const FColor Color = Endpoint.TransportFailures + Endpoint.HttpErrors > 0 ? FColor::Orange : FColor::Cyan;
+        TimingOverlay.ShowLine(Line, Color, Message);
+        ++Line;
+    }
+}
+
+void FFusionRequestTelemetry::Reset()
+{
+    Endpoints.Reset();
+}
+
+static FAutoConsoleCommand GFusionDumpTimingsCommand(
+    TEXT("Fusion.Net.DumpTimings"),
+    TEXT("Writes per-endpoint HTTP phase histograms (queue, upload, server, download, total) to CSV. ")
+    TEXT("Args: optional file path, relative to Saved/Telemetry; default FusionRequestTimings-<time>.csv"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const FString FilePath = Args.Num() > 0 ? Args[0] : FString::Printf(TEXT("FusionRequestTimings-%s.csv"), *FDateTime::Now().ToString());
+        FFusionRequestTelemetry::Get().DumpCsv(FilePath);
+    }));
+
+static FAutoConsoleCommand GFusionResetTimingsCommand(
+    TEXT("Fusion.Net.ResetTimings"),
+    TEXT("Clears the collected HTTP timing histograms."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        FFusionRequestTelemetry::Get().Reset();
+    }));
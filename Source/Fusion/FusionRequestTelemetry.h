@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+/** Timestamps (FPlatformTime::Seconds) of one HTTP request; 0 means the point was not observed. */
+struct FFusionRequestTiming
+{
+    /** Request URL without its query string. */
+    FString Endpoint;
+
+    /** When the caller first asked for the request; equals SendStartTime for requests that never wait. */
+    double QueuedTime = 0.0;
+
+    /** ProcessRequest was called. Connection setup is not reported separately by the HTTP module and counts as upload. */
+    double SendStartTime = 0.0;
+
+    /** The whole request body was handed to the connection. */
+    double UploadCompleteTime = 0.0;
+
+    /** The first response bytes arrived. */
+    double FirstByteTime = 0.0;
+
+    double CompleteTime = 0.0;
+
+    uint64 BytesSent = 0;
+    uint64 BytesReceived = 0;
+};
+
+/** Phases derived from FFusionRequestTiming, each kept as its own histogram. */
+enum class EFusionRequestPhase : uint8
+{
+    /** Queued to send start: waiting for a scheduler slot or retry backoff. */
+    Queue,
+    /** Send start to upload complete: connection setup plus request body. */
+    Upload,
+    /** Upload complete to first byte: server processing. */
+    Server,
+    /** First byte to complete: response body. */
+    Download,
+    /** Queued to complete. */
+    Total,
+    Num
+};
+
+/** Log-scale latency histogram; bucket N counts samples up to 1ms * 2^N, the last bucket everything slower. */
+struct FFusionLatencyHistogram
+{
+    static constexpr int32 NumBuckets = 17;
+
+    void Add(double Seconds);
+
+    /** Upper bound of the bucket holding the given percentile (0-1), capped at the slowest sample seen. */
+    double GetPercentile(double Percentile) const;
+
+    double GetMean() const { return Count > 0 ? SumSeconds / Count : 0.0; }
+
+    /** Upper bound of a bucket in seconds; the last bucket is unbounded. */
+    static double GetBucketUpperBound(int32 Bucket);
+
+    uint32 Buckets[NumBuckets] = {};
+    uint32 Count = 0;
+    double SumSeconds = 0.0;
+    double MaxSeconds = 0.0;
+};
+
+/**
+ * Process-wide HTTP timing telemetry for the AI endpoints. Requests are tracked from send start through request
+ * progress callbacks, and completed requests are aggregated per endpoint and phase. Game thread only.
+ *
+ * Console: Fusion.Net.DumpTimings [File.csv], Fusion.Net.ResetTimings, Fusion.Net.TimingOverlay 0|1.
+ */
+class FUSION_API FFusionRequestTelemetry
+{
+public:
+    static FFusionRequestTelemetry& Get();
+
+    /**
+     * Binds the request's progress delegate to record upload complete and first byte. Call right before
+     * ProcessRequest, after the body is set. QueuedTime 0 means the request did not wait.
+     */
+    static TSharedRef<FFusionRequestTiming> Track(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, double QueuedTime = 0.0);
+
+    /** Stamps completion and aggregates the timing. Transport failures are only counted, not added to histograms. */
+    void RecordCompleted(FFusionRequestTiming& Timing, const FHttpResponsePtr& Response);
+
+    /** Counts a request that was cancelled or abandoned before it completed. */
+    void RecordAbandoned(const FFusionRequestTiming& Timing);
+
+    /** Writes one row per endpoint and phase with counts, percentiles and bucket counts; relative paths go under Saved/Telemetry. */
+    bool DumpCsv(const FString& FilePath) const;
+
+    /** Shows per-endpoint phase percentiles on screen while Fusion.Net.TimingOverlay is set; call periodically. */
+    void UpdateDebugOverlay();
+
+    void Reset();
+
+    static const TCHAR* GetPhaseName(EFusionRequestPhase Phase);
+
+    static FString MakeEndpointKey(const FString& Url);
+
+private:
+    struct FEndpointTimings
+    {
+        FFusionLatencyHistogram Phases[static_cast<int32>(EFusionRequestPhase::Num)];
+        uint32 Completed = 0;
+        /** Responses with status 400 or above; still timed. */
+        uint32 HttpErrors = 0;
+        /** No response at all; not timed. */
+        uint32 TransportFailures = 0;
+        uint32 Abandoned = 0;
+    };
+
+    TMap<FString, FEndpointTimings> Endpoints;
+    double LastOverlayUpdate = 0.0;
+};
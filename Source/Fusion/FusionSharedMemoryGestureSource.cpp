@@ -0,0 +1,308 @@
+#include "FusionSharedMemoryGestureSource.h"
+
+#if PLATFORM_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogFusionSharedMemory, Log, All);
+
+namespace
+{
+    /** How often a missing ring is looked for, and how long a silent ring is trusted before reattaching. */
+    constexpr double AttachRetrySeconds = 1.0;
+
+    FString MakeShmName(const FString& Name)
+    {
+        return Name.StartsWith(TEXT("/")) ? Name : TEXT("/") + Name;
+    }
+
+    FString ReadFixedString(const char* Text, int32 Capacity)
+    {
+        int32 Length = 0;
+        while (Length < Capacity && Text[Length] != '\0')
+        {
+            ++Length;
+        }
+        const FUTF8ToTCHAR Converted(Text, Length);
+        return FString(Converted.Length(), Converted.Get());
+    }
+}
+
+FFusionSharedMemoryGestureSource::FFusionSharedMemoryGestureSource(const FString& InName)
+    : Name(MakeShmName(InName))
+{
+#if !PLATFORM_LINUX
+    UE_LOG(LogFusionSharedMemory, Warning, TEXT("Shared-memory gesture transport is only available on Linux; no frames will arrive from %s."), *Name);
+#endif
+}
+
+FFusionSharedMemoryGestureSource::~FFusionSharedMemoryGestureSource()
+{
+    Detach();
+}
+
+void FFusionSharedMemoryGestureSource::Poll(TArray<FFusionGestureFrame>& OutFrames)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (!Header)
+    {
+        if (Now < NextAttachTime)
+        {
+            return;
+        }
+        NextAttachTime = Now + AttachRetrySeconds;
+        if (!Attach())
+        {
+            return;
+        }
+    }
+
+    const uint64 Published = Header->PublishedFrames.load(std::memory_order_acquire);
+    if (Published == NextFrame)
+    {
+        // A tracker that unlinked and recreated the ring keeps writing to a new object; look for it once idle.
+        if (Now >= NextAttachTime)
+        {
+            Detach();
+        }
+        return;
+    }
+    NextAttachTime = Now + AttachRetrySeconds;
+
+    if (Published < NextFrame)
+    {
+        UE_LOG(LogFusionSharedMemory, Log, TEXT("Gesture ring %s restarted"), *Name);
+        NextFrame = Published;
+        return;
+    }
+
+    if (Published - NextFrame > SlotCount)
+    {
+        FramesOverrun += Published - NextFrame - SlotCount;
+        NextFrame = Published - SlotCount;
+    }
+
+    for (; NextFrame < Published; ++NextFrame)
+    {
+        FFusionGestureFrame Frame;
+        if (TryReadSlot(NextFrame, Frame))
+        {
+            OutFrames.Add(MoveTemp(Frame));
+            ++FramesRead;
+        }
+        else
+        {
+            ++FramesOverrun;
+        }
+    }
+}
+
+FFusionGestureTransportStats FFusionSharedMemoryGestureSource::GetStats() const
+{
+    FFusionGestureTransportStats Stats;
+    Stats.Transport = GetName();
+    Stats.bConnected = IsConnected();
+    Stats.FramesReceived = static_cast<int32>(FramesRead);
+    Stats.FramesDelivered = static_cast<int32>(FramesRead);
+    Stats.FramesLost = static_cast<int32>(FramesOverrun);
+    return Stats;
+}
+
+bool FFusionSharedMemoryGestureSource::TryReadSlot(uint64 FrameNumber, FFusionGestureFrame& OutFrame) const
+{
+    using namespace FusionGestureShm;
+
+    const FSlot* Slot = reinterpret_cast<const FSlot*>(Slots + (FrameNumber % SlotCount) * SlotSize);
+    const uint64 Expected = 2 * FrameNumber + 2;
+    if (Slot->Sequence.load(std::memory_order_acquire) != Expected)
+    {
+        return false;
+    }
+
+    // Copy everything after the sequence word, then confirm the writer did not touch the slot meanwhile.
+    constexpr SIZE_T PayloadOffset = STRUCT_OFFSET(FSlot, CaptureTimestamp);
+    alignas(FSlot) uint8 Buffer[sizeof(FSlot)];
+    FMemory::Memcpy(Buffer + PayloadOffset, reinterpret_cast<const uint8*>(Slot) + PayloadOffset, sizeof(FSlot) - PayloadOffset);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (Slot->Sequence.load(std::memory_order_relaxed) != Expected)
+    {
+        return false;
+    }
+
+    const FSlot& Copy = *reinterpret_cast<const FSlot*>(Buffer);
+    OutFrame.Sequence = static_cast<int64>(FrameNumber);
+    OutFrame.CaptureTimestamp = Copy.CaptureTimestamp;
+    OutFrame.Gesture = ReadFixedString(Copy.Gesture, UE_ARRAY_COUNT(Copy.Gesture));
+    OutFrame.ObjectHint = ReadFixedString(Copy.ObjectId, UE_ARRAY_COUNT(Copy.ObjectId));
+
+    const int32 NumHands = FMath::Min(static_cast<int32>(Copy.NumHands), MaxHands);
+    OutFrame.Hands.Reserve(NumHands);
+    for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex)
+    {
+        const FHand& Hand = Copy.Hands[HandIndex];
+        FFusionHandSnapshot& Snapshot = OutFrame.Hands.AddDefaulted_GetRef();
+        Snapshot.state = ReadFixedString(Hand.State, UE_ARRAY_COUNT(Hand.State));
+        Snapshot.Handedness = ReadFixedString(Hand.Handedness, UE_ARRAY_COUNT(Hand.Handedness));
+        Snapshot.x_y_z.Append(Hand.Landmarks, FMath::Min(static_cast<int32>(Hand.NumLandmarks), MaxLandmarks) * 3);
+    }
+    return true;
+}
+
+bool FFusionSharedMemoryGestureSource::Attach()
+{
+#if PLATFORM_LINUX
+    using namespace FusionGestureShm;
+
+    const int Descriptor = shm_open(TCHAR_TO_UTF8(*Name), O_RDONLY, 0);
+    if (Descriptor < 0)
+    {
+        return false;
+    }
+
+    struct stat Info;
+    void* Mapping = MAP_FAILED;
+    if (fstat(Descriptor, &Info) == 0 && static_cast<SIZE_T>(Info.st_size) >= sizeof(FHeader))
+    {
+        Mapping = mmap(nullptr, Info.st_size, PROT_READ, MAP_SHARED, Descriptor, 0);
+    }
+    close(Descriptor);
+    if (Mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    const FHeader* Candidate = static_cast<const FHeader*>(Mapping);
+    const uint32 CandidateMagic = Candidate->Magic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const bool bValid = CandidateMagic == Magic && Candidate->Version == Version && Candidate->SlotCount > 0
+        && Candidate->SlotSize >= sizeof(FSlot) && Candidate->SlotSize % alignof(FSlot) == 0
+        && sizeof(FHeader) + static_cast<SIZE_T>(Candidate->SlotCount) * Candidate->SlotSize <= static_cast<SIZE_T>(Info.st_size);
+    if (!bValid)
+    {
+        UE_LOG(LogFusionSharedMemory, Warning, TEXT("%s is not a version %u gesture ring"), *Name, Version);
+        munmap(Mapping, Info.st_size);
+        return false;
+    }
+
+    Header = Candidate;
+    Slots = static_cast<const uint8*>(Mapping) + sizeof(FHeader);
+    MappedSize = Info.st_size;
+    SlotCount = Candidate->SlotCount;
+    SlotSize = Candidate->SlotSize;
+
+    // Start at the live edge; frames written before we attached are stale for a pointer.
+    NextFrame = Header->PublishedFrames.load(std::memory_order_acquire);
+    UE_LOG(LogFusionSharedMemory, Verbose, TEXT("Attached to gesture ring %s (%u slots)"), *Name, SlotCount);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FFusionSharedMemoryGestureSource::Detach()
+{
+#if PLATFORM_LINUX
+    if (Header)
+    {
+        munmap(const_cast<FusionGestureShm::FHeader*>(Header), MappedSize);
+    }
+#endif
+    Header = nullptr;
+    Slots = nullptr;
+    MappedSize = 0;
+}
+
+FFusionSharedMemoryGestureWriter::~FFusionSharedMemoryGestureWriter()
+{
+    Close();
+}
+
+bool FFusionSharedMemoryGestureWriter::Open(const FString& InName, uint32 InSlotCount)
+{
+    using namespace FusionGestureShm;
+
+    Close();
+
+#if PLATFORM_LINUX
+    Name = MakeShmName(InName);
+    const uint32 NumSlots = FMath::Max(2u, InSlotCount);
+    const SIZE_T Size = sizeof(FHeader) + static_cast<SIZE_T>(NumSlots) * sizeof(FSlot);
+
+    // Recreated rather than reused so a reader still mapped to an older ring notices and reattaches.
+    shm_unlink(TCHAR_TO_UTF8(*Name));
+    const int Descriptor = shm_open(TCHAR_TO_UTF8(*Name), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (Descriptor < 0)
+    {
+        UE_LOG(LogFusionSharedMemory, Error, TEXT("Could not create gesture ring %s"), *Name);
+        return false;
+    }
+
+    void* Mapping = ftruncate(Descriptor, Size) == 0 ? mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, Descriptor, 0) : MAP_FAILED;
+    close(Descriptor);
+    if (Mapping == MAP_FAILED)
+    {
+        UE_LOG(LogFusionSharedMemory, Error, TEXT("Could not map gesture ring %s"), *Name);
+        shm_unlink(TCHAR_TO_UTF8(*Name));
+        return false;
+    }
+
+    FMemory::Memzero(Mapping, Size);
+    Header = static_cast<FHeader*>(Mapping);
+    Slots = static_cast<uint8*>(Mapping) + sizeof(FHeader);
+    MappedSize = Size;
+    NextFrame = 0;
+
+    Header->Version = Version;
+    Header->SlotCount = NumSlots;
+    Header->SlotSize = sizeof(FSlot);
+    std::atomic_thread_fence(std::memory_order_release);
+    Header->Magic = Magic;
+    return true;
+#else
+    UE_LOG(LogFusionSharedMemory, Warning, TEXT("Shared-memory gesture transport is only available on Linux."));
+    return false;
+#endif
+}
+
+void FFusionSharedMemoryGestureWriter::WriteString(char* Target, int32 Capacity, const FString& Text)
+{
+    const FTCHARToUTF8 Converted(*Text, Text.Len());
+    const int32 Length = FMath::Min(Converted.Length(), Capacity - 1);
+    FMemory::Memcpy(Target, Converted.Get(), Length);
+    Target[Length] = '\0';
+}
+
+void FFusionSharedMemoryGestureWriter::Close()
+{
+#if PLATFORM_LINUX
+    if (Header)
+    {
+        munmap(Header, MappedSize);
+        shm_unlink(TCHAR_TO_UTF8(*Name));
+    }
+#endif
+    Header = nullptr;
+    Slots = nullptr;
+    MappedSize = 0;
+}
+
+FusionGestureShm::FSlot& FFusionSharedMemoryGestureWriter::BeginWrite()
+{
+    check(Header);
+    FusionGestureShm::FSlot& Slot = *reinterpret_cast<FusionGestureShm::FSlot*>(Slots + (NextFrame % Header->SlotCount) * Header->SlotSize);
+    Slot.Sequence.store(2 * NextFrame + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return Slot;
+}
+
+void FFusionSharedMemoryGestureWriter::EndWrite()
+{
+    check(Header);
+    FusionGestureShm::FSlot& Slot = *reinterpret_cast<FusionGestureShm::FSlot*>(Slots + (NextFrame % Header->SlotCount) * Header->SlotSize);
+    Slot.Sequence.store(2 * NextFrame + 2, std::memory_order_release);
+    ++NextFrame;
+    Header->PublishedFrames.store(NextFrame, std::memory_order_release);
+}
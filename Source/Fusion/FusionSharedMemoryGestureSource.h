@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "FusionGestureSource.h"
+
+/**
+ * Layout of the gesture ring a co-located tracker writes into a POSIX shared-memory object. All integers are
+ * little-endian; strings are NUL-terminated UTF-8.
+ *
+ * The object starts with FHeader, followed by SlotCount FSlot records. Frame N (counting from 0) goes to slot
+ * N % SlotCount under a seqlock: the writer stores Sequence = 2N+1, writes the payload, stores Sequence = 2N+2 with
+ * release order and finally PublishedFrames = N+1. A reader copies a slot and accepts it only if Sequence read
+ * 2N+2 both before and after the copy, so it never blocks the writer and never sees a torn frame.
+ */
+namespace FusionGestureShm
+{
+    constexpr uint32 Magic = 0x31524746; // "FGR1"
+    constexpr uint32 Version = 1;
+    constexpr int32 MaxHands = 4;
+    constexpr int32 MaxLandmarks = 21;
+
+    struct FHand
+    {
+        char State[32];
+        char Handedness[16];
+        uint32 NumLandmarks;
+        uint32 Reserved;
+
+        /** x, y, z per landmark, in the same normalised space as the WebSocket "x_y_z" arrays. */
+        float Landmarks[MaxLandmarks * 3];
+    };
+
+    struct FSlot
+    {
+        std::atomic<uint64> Sequence;
+
+        /** Tracker clock in seconds when the camera frame was captured. */
+        double CaptureTimestamp;
+
+        char Gesture[32];
+        char ObjectId[64];
+        uint32 NumHands;
+        uint32 Reserved;
+        FHand Hands[MaxHands];
+    };
+
+    struct FHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint32 SlotCount;
+        uint32 SlotSize;
+        std::atomic<uint64> PublishedFrames;
+        uint8 Padding[40];
+    };
+
+    static_assert(std::atomic<uint64>::is_always_lock_free, "The ring is shared with other processes and needs lock-free 64-bit atomics");
+    static_assert(sizeof(std::atomic<uint64>) == sizeof(uint64), "Atomics must have the layout of plain integers");
+    static_assert(sizeof(FHeader) == 64, "Header layout is part of the protocol");
+}
+
+/**
+ * Reads gesture frames from the shared-memory ring described above (Linux only). Each poll is a few atomic loads and
+ * memcpys, with no syscalls or JSON; frames the writer lapped before they were read are counted and skipped.
+ * Reattaches automatically when the tracker is started later or recreates the ring.
+ */
+class FUSION_API FFusionSharedMemoryGestureSource : public IFusionGestureSource
+{
+public:
+    explicit FFusionSharedMemoryGestureSource(const FString& InName);
+    virtual ~FFusionSharedMemoryGestureSource() override;
+
+    virtual void Poll(TArray<FFusionGestureFrame>& OutFrames) override;
+    virtual bool IsConnected() const override { return Header != nullptr; }
+    virtual const TCHAR* GetName() const override { return TEXT("SharedMemory"); }
+
+    /** Frames overwritten by the writer before this reader got to them, or caught mid-write, count as lost. */
+    virtual FFusionGestureTransportStats GetStats() const override;
+
+private:
+    bool Attach();
+    void Detach();
+    bool TryReadSlot(uint64 FrameNumber, FFusionGestureFrame& OutFrame) const;
+
+    FString Name;
+    double NextAttachTime = 0.0;
+
+    const FusionGestureShm::FHeader* Header = nullptr;
+    const uint8* Slots = nullptr;
+    SIZE_T MappedSize = 0;
+    uint32 SlotCount = 0;
+    uint32 SlotSize = 0;
+
+    /** Next frame number to read. */
+    uint64 NextFrame = 0;
+
+    uint64 FramesRead = 0;
+    uint64 FramesOverrun = 0;
+};
+
+/** Creates and fills the ring; used by the mock backend and as a reference for tracker-side writers. Single writer. */
+class FUSION_API FFusionSharedMemoryGestureWriter
+{
+public:
+    ~FFusionSharedMemoryGestureWriter();
+
+    bool Open(const FString& InName, uint32 InSlotCount = 8);
+    void Close();
+    bool IsOpen() const { return Header != nullptr; }
+
+    /** Returns the slot for the next frame with its seqlock taken; fill it, then call EndWrite. */
+    FusionGestureShm::FSlot& BeginWrite();
+    void EndWrite();
+
+    /** Copies Text into a fixed-size slot field, truncating and NUL-terminating it. */
+    static void WriteString(char* Target, int32 Capacity, const FString& Text);
+
+private:
+    FString Name;
+    FusionGestureShm::FHeader* Header = nullptr;
+    uint8* Slots = nullptr;
+    SIZE_T MappedSize = 0;
+    uint64 NextFrame = 0;
+};
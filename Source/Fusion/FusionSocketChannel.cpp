@@ -0,0 +1,269 @@
+#include "FusionSocketChannel.h"
+
+#include "Dom/JsonObject.h"
+#include "IWebSocket.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFusionSocketChannel, Log, All);
+
+namespace
+{
+    constexpr uint8 BinaryFrameMagic[4] = { 'F', 'S', 'B', '1' };
+    constexpr int32 BinaryFrameHeaderOffset = 8;
+
+    FString WriteCondensedJson(const TSharedRef<FJsonObject>& Object)
+    {
+        FString Text;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+        FJsonSerializer::Serialize(Object, Writer);
+        return Text;
+    }
+}
+
+void FFusionSocketChannel::SetSocket(const TSharedPtr<IWebSocket>& InSocket)
+{
+    Socket = InSocket;
+}
+
+bool FFusionSocketChannel::IsAvailable() const
+{
+    return !bRejectedByServer && Socket.IsValid() && Socket->IsConnected();
+}
+
+bool FFusionSocketChannel::Send(FRequest&& Request, const TSharedRef<FJsonObject>& Message)
+{
+    const uint64 RequestId = NextRequestId;
+    return SendPrepared(MoveTemp(Request), RequestId, [&Message, RequestId](IWebSocket& Target)
+    {
+        Message->SetNumberField(TEXT("request_id"), static_cast<double>(RequestId));
+        Target.Send(WriteCondensedJson(Message));
+    });
+}
+
+bool FFusionSocketChannel::SendBinary(FRequest&& Request, const TSharedRef<FJsonObject>& Header, TConstArrayView<uint8> Payload)
+{
+    const uint64 RequestId = NextRequestId;
+    return SendPrepared(MoveTemp(Request), RequestId, [&Header, Payload, RequestId](IWebSocket& Target)
+    {
+        Header->SetNumberField(TEXT("request_id"), static_cast<double>(RequestId));
+        const TArray<uint8> Frame = EncodeBinaryFrame(WriteCondensedJson(Header), Payload);
+        Target.Send(Frame.GetData(), Frame.Num(), true);
+    });
+}
+
+bool FFusionSocketChannel::SendPrepared(FRequest&& Request, uint64 RequestId, TFunctionRef<void(IWebSocket&)> SendMessage)
+{
+    if (!IsAvailable())
+    {
+        return false;
+    }
+
+    Cancel(Request.Key);
+
+    ++NextRequestId;
+    FPending& Entry = Pending.Add(RequestId);
+    Entry.Request = MoveTemp(Request);
+    Entry.SendTime = FPlatformTime::Seconds();
+
+    SendMessage(*Socket);
+    return true;
+}
+
+bool FFusionSocketChannel::HandleMessage(const FJsonObject& Message)
+{
+    int64 RequestId = 0;
+    FString RequestIdText;
+    if (!Message.TryGetNumberField(TEXT("request_id"), RequestId))
+    {
+        if (!Message.TryGetStringField(TEXT("request_id"), RequestIdText))
+        {
+            return false;
+        }
+        RequestId = FCString::Atoi64(*RequestIdText);
+    }
+
+    FPending* Entry = Pending.Find(static_cast<uint64>(RequestId));
+    if (!Entry)
+    {
+        // Late reply to a request that was cancelled or expired.
+        return true;
+    }
+
+    FString Type;
+    Message.TryGetStringField(TEXT("type"), Type);
+    if (Type == TEXT("error"))
+    {
+        FString Code;
+        FString Reason;
+        Message.TryGetStringField(TEXT("code"), Code);
+        Message.TryGetStringField(TEXT("message"), Reason);
+        UE_LOG(LogFusionSocketChannel, Warning, TEXT("Socket request '%s' failed: %s %s"), *Entry->Request.Key, *Code, *Reason);
+
+        if (Code == TEXT("unsupported"))
+        {
+            UE_LOG(LogFusionSocketChannel, Warning, TEXT("Server does not accept requests over the gesture socket; using HTTP."));
+            bRejectedByServer = true;
+        }
+
+        Fail(static_cast<uint64>(RequestId), EFusionRequestOutcome::Failed);
+        return true;
+    }
+
+    // The handler may send or cancel requests, so it runs on a copy and the entry is looked up again afterwards.
+    const FReplyHandler OnReply = Entry->Request.OnReply;
+    if (!OnReply || OnReply(Message))
+    {
+        Pending.Remove(static_cast<uint64>(RequestId));
+    }
+    return true;
+}
+
+bool FFusionSocketChannel::Cancel(const FString& Key)
+{
+    const uint64 RequestId = FindPending(Key);
+    if (RequestId == 0)
+    {
+        return false;
+    }
+
+    if (Socket.IsValid() && Socket->IsConnected())
+    {
+        Socket->Send(FString::Printf(TEXT("{\"type\":\"cancel\",\"request_id\":%llu}"), RequestId));
+    }
+
+    Fail(RequestId, EFusionRequestOutcome::Cancelled);
+    return true;
+}
+
+int32 FFusionSocketChannel::CancelPriority(EFusionRequestPriority Priority)
+{
+    TArray<FString> Keys;
+    for (const TPair<uint64, FPending>& Pair : Pending)
+    {
+        if (Pair.Value.Request.Priority == Priority)
+        {
+            Keys.Add(Pair.Value.Request.Key);
+        }
+    }
+
+    int32 NumCancelled = 0;
+    for (const FString& Key : Keys)
+    {
+        NumCancelled += Cancel(Key) ? 1 : 0;
+    }
+    return NumCancelled;
+}
+
+bool FFusionSocketChannel::IsPending(const FString& Key) const
+{
+    return FindPending(Key) != 0;
+}
+
+void FFusionSocketChannel::Tick()
+{
+    const double Now = FPlatformTime::Seconds();
+
+    TArray<uint64> Overdue;
+    for (const TPair<uint64, FPending>& Pair : Pending)
+    {
+        const float Deadline = Pair.Value.Request.DeadlineSeconds;
+        if (Deadline > 0.f && Now - Pair.Value.SendTime > Deadline)
+        {
+            Overdue.Add(Pair.Key);
+        }
+    }
+
+    for (const uint64 RequestId : Overdue)
+    {
+        UE_LOG(LogFusionSocketChannel, Warning, TEXT("Socket request '%s' expired"), *Pending.FindChecked(RequestId).Request.Key);
+        Fail(RequestId, EFusionRequestOutcome::Expired);
+    }
+}
+
+void FFusionSocketChannel::FailAll(EFusionRequestOutcome Outcome)
+{
+    TArray<uint64> RequestIds;
+    Pending.GetKeys(RequestIds);
+    for (const uint64 RequestId : RequestIds)
+    {
+        Fail(RequestId, Outcome);
+    }
+}
+
+void FFusionSocketChannel::Fail(uint64 RequestId, EFusionRequestOutcome Outcome)
+{
+    FPending Entry;
+    if (!Pending.RemoveAndCopyValue(RequestId, Entry))
+    {
+        return;
+    }
+
+    if (Entry.Request.OnFailed)
+    {
+        Entry.Request.OnFailed(Outcome);
+    }
+}
+
+uint64 FFusionSocketChannel::FindPending(const FString& Key) const
+{
+    if (Key.IsEmpty())
+    {
+        return 0;
+    }
+
+    for (const TPair<uint64, FPending>& Pair : Pending)
+    {
+        if (Pair.Value.Request.Key == Key)
+        {
+            return Pair.Key;
+        }
+    }
+    return 0;
+}
+
+bool FFusionSocketChannel::IsBinaryFrame(const uint8* Data, int32 Size)
+{
+    return Data && Size >= BinaryFrameHeaderOffset && FMemory::Memcmp(Data, BinaryFrameMagic, sizeof(BinaryFrameMagic)) == 0;
+}
+
+TArray<uint8> FFusionSocketChannel::EncodeBinaryFrame(const FString& HeaderJson, TConstArrayView<uint8> Payload)
+{
+    const FTCHARToUTF8 Header(*HeaderJson, HeaderJson.Len());
+    const uint32 HeaderLength = static_cast<uint32>(Header.Length());
+
+    TArray<uint8> Frame;
+    Frame.Reserve(BinaryFrameHeaderOffset + Header.Length() + Payload.Num());
+    Frame.Append(BinaryFrameMagic, sizeof(BinaryFrameMagic));
+    for (int32 Shift = 0; Shift < 32; Shift += 8)
+    {
+        Frame.Add(static_cast<uint8>(HeaderLength >> Shift));
+    }
+    Frame.Append(reinterpret_cast<const uint8*>(Header.Get()), Header.Length());
+    Frame.Append(Payload.GetData(), Payload.Num());
+    return Frame;
+}
+
+bool FFusionSocketChannel::DecodeBinaryFrame(TConstArrayView<uint8> Frame, FString& OutHeaderJson, TConstArrayView<uint8>& OutPayload)
+{
+    if (!IsBinaryFrame(Frame.GetData(), Frame.Num()))
+    {
+        return false;
+    }
+
+    uint32 HeaderLength = 0;
+    for (int32 Index = 0; Index < 4; ++Index)
+    {
+        HeaderLength |= static_cast<uint32>(Frame[sizeof(BinaryFrameMagic) + Index]) << (8 * Index);
+    }
+    if (HeaderLength > static_cast<uint32>(Frame.Num() - BinaryFrameHeaderOffset))
+    {
+        return false;
+    }
+
+    const FUTF8ToTCHAR Header(reinterpret_cast<const ANSICHAR*>(Frame.GetData() + BinaryFrameHeaderOffset), static_cast<int32>(HeaderLength));
+    OutHeaderJson = FString(Header.Length(), Header.Get());
+    OutPayload = Frame.RightChop(BinaryFrameHeaderOffset + static_cast<int32>(HeaderLength));
+    return true;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FusionRequestScheduler.h"
+
+class IWebSocket;
+class FJsonObject;
+
+/**
+ * Request/response correlation for AI traffic multiplexed over the gesture WebSocket. Requests are JSON text messages,
+ * or binary frames carrying a JSON header followed by raw audio, tagged with a request_id that every reply echoes.
+ * Replies of type "error" fail the request; the reply handler decides which other reply completes it. Game thread only.
+ *
+ * Binary frame layout: "FSB1", uint32 little-endian header length, UTF-8 JSON header, payload bytes.
+ */
+class FUSION_API FFusionSocketChannel
+{
+public:
+    /** Called for every non-error reply; returns true when that reply was the last one for the request. */
+    using FReplyHandler = TFunction<bool(const FJsonObject& Reply)>;
+    using FFailureHandler = TFunction<void(EFusionRequestOutcome Outcome)>;
+
+    struct FRequest
+    {
+        /** Same keys as the request scheduler; sending a key that is still pending cancels the older request. */
+        FString Key;
+        EFusionRequestPriority Priority = EFusionRequestPriority::Description;
+
+        /** Seconds until the request fails as Expired (0 = no deadline). */
+        float DeadlineSeconds = 0.f;
+
+        FReplyHandler OnReply;
+        FFailureHandler OnFailed;
+    };
+
+    void SetSocket(const TSharedPtr<IWebSocket>& InSocket);
+
+    /** True while the socket is connected and the server has not rejected multiplexed requests. */
+    bool IsAvailable() const;
+
+    /** Sends Message with a fresh request_id added; returns false without calling any handler if unavailable. */
+    bool Send(FRequest&& Request, const TSharedRef<FJsonObject>& Message);
+
+    /** Sends a binary frame whose header gets the request_id. */
+    bool SendBinary(FRequest&& Request, const TSharedRef<FJsonObject>& Header, TConstArrayView<uint8> Payload);
+
+    /** Consumes every message carrying a request_id, including late replies to finished requests. */
+    bool HandleMessage(const FJsonObject& Message);
+
+    bool Cancel(const FString& Key);
+    int32 CancelPriority(EFusionRequestPriority Priority);
+    bool IsPending(const FString& Key) const;
+
+    /** Fails requests that ran past their deadline. */
+    void Tick();
+
+    /** Fails every pending request, e.g. after the socket closed; failure handlers usually resend over HTTP. */
+    void FailAll(EFusionRequestOutcome Outcome);
+
+    static bool IsBinaryFrame(const uint8* Data, int32 Size);
+    static TArray<uint8> EncodeBinaryFrame(const FString& HeaderJson, TConstArrayView<uint8> Payload);
+    static bool DecodeBinaryFrame(TConstArrayView<uint8> Frame, FString& OutHeaderJson, TConstArrayView<uint8>& OutPayload);
+
+private:
+    struct FPending
+    {
+        FRequest Request;
+        double SendTime = 0.0;
+    };
+
+    bool SendPrepared(FRequest&& Request, uint64 RequestId, TFunctionRef<void(IWebSocket&)> SendMessage);
+    void Fail(uint64 RequestId, EFusionRequestOutcome Outcome);
+    uint64 FindPending(const FString& Key) const;
+
+    TSharedPtr<IWebSocket> Socket;
+    TMap<uint64, FPending> Pending;
+    uint64 NextRequestId = 1;
+
+    /** Set when the server answers a request with an "unsupported" error; traffic goes back to HTTP for the session. */
+    bool bRejectedByServer = false;
+};
@@ -0,0 +1,728 @@
+#include "FusionTtsComponent.h"
+
+#include "Async/Async.h"
+#include "Components/AudioComponent.h"
+#include "FusionMode.h"
+#include "FusionRequestScheduler.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+#include "Sound/SoundWaveProcedural.h"
+#include "Tasks/Task.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFusionTts, Log, All);
+
+namespace FusionTts
+{
+	struct FWavFormat
+	{
+		int32 SampleRate = 0;
+		int32 NumChannels = 0;
+		int32 DataOffset = 0;
+		uint32 DataSize = 0;
+
+		int32 GetBlockAlign() const { return NumChannels * static_cast<int32>(sizeof(int16)); }
+
+		/** Streaming TTS servers often write 0 or 0xFFFFFFFF when the length is not known up front. */
+		float GetDuration() const
+		{
+			const bool bKnownSize = DataSize != 0 && DataSize != 0xFFFFFFFF;
+			return bKnownSize && SampleRate > 0 ? static_cast<float>(DataSize) / (SampleRate * GetBlockAlign()) : -1.f;
+		}
+	};
+
+	enum class EParseResult : uint8
+	{
+		NeedMoreData,
+		Parsed,
+		Unsupported
+	};
+
+	static uint32 ReadUint32(const uint8* Data)
+	{
+		return Data[0] | (Data[1] << 8) | (Data[2] << 16) | (static_cast<uint32>(Data[3]) << 24);
+	}
+
+	static uint16 ReadUint16(const uint8* Data)
+	{
+		return static_cast<uint16>(Data[0] | (Data[1] << 8));
+	}
+
+	/** Finds the fmt and data chunks of a 16-bit PCM RIFF/WAVE stream. */
+	static EParseResult ParseWavFormat(const uint8* Data, int32 Num, FWavFormat& OutFormat)
+	{
+		if (Num < 12)
+		{
+			return EParseResult::NeedMoreData;
+		}
+		if (FMemory::Memcmp(Data, "RIFF", 4) != 0 || FMemory::Memcmp(Data + 8, "WAVE", 4) != 0)
+		{
+			return EParseResult::Unsupported;
+		}
+
+		bool bHasFormat = false;
+		int64 Offset = 12;
+		while (Offset + 8 <= Num)
+		{
+			const uint8* Chunk = Data + Offset;
+			const uint32 ChunkSize = ReadUint32(Chunk + 4);
+
+			if (FMemory::Memcmp(Chunk, "fmt ", 4) == 0)
+			{
+				if (Offset + 8 + 16 > Num)
+				{
+					return EParseResult::NeedMoreData;
+				}
+
+				const uint16 FormatTag = ReadUint16(Chunk + 8);
+				const uint16 BitsPerSample = ReadUint16(Chunk + 22);
+				OutFormat.NumChannels = ReadUint16(Chunk + 10);
+				OutFormat.SampleRate = static_cast<int32>(ReadUint32(Chunk + 12));
+				if (FormatTag != 1 || BitsPerSample != 16 || OutFormat.NumChannels <= 0 || OutFormat.SampleRate <= 0)
+				{
+					return EParseResult::Unsupported;
+				}
+				bHasFormat = true;
+			}
+			else if (FMemory::Memcmp(Chunk, "data", 4) == 0)
+			{
+				if (!bHasFormat)
+				{
+					return EParseResult::Unsupported;
+				}
+
+				OutFormat.DataOffset = static_cast<int32>(Offset + 8);
+				OutFormat.DataSize = ChunkSize;
+				return EParseResult::Parsed;
+			}
+
+			Offset += 8 + static_cast<int64>(ChunkSize) + (ChunkSize & 1);
+		}
+
+		return EParseResult::NeedMoreData;
+	}
+
+	/** Scheme and authority of a URL, so that every clip from one TTS server shares a concurrency cap and breaker. */
+	FString GetServerKey(const FString& Url)
+	{
+		const int32 SchemeEnd = Url.Find(TEXT("://"));
+		const int32 AuthorityStart = SchemeEnd == INDEX_NONE ? 0 : SchemeEnd + 3;
+		const int32 PathStart = Url.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, AuthorityStart);
+		return PathStart == INDEX_NONE ? Url : Url.Left(PathStart);
+	}
+}
+
+/** Download state shared between the HTTP thread (appending bytes) and the game thread (playback, caching). */
+class FFusionTtsStream
+{
+public:
+	explicit FFusionTtsStream(const FString& InUrl)
+		: Url(InUrl)
+	{
+	}
+
+	const FString Url;
+
+	/** HTTP thread. Returns true when this call completed the wav header while playback was waiting for it. */
+	bool Append(const uint8* Data, int64 Length)
+	{
+		FScopeLock ScopeLock(&Lock);
+		Bytes.Append(Data, static_cast<int32>(Length));
+
+		const bool bHadFormat = ParseResult == FusionTts::EParseResult::Parsed;
+		if (ParseResult == FusionTts::EParseResult::NeedMoreData)
+		{
+			ParseResult = FusionTts::ParseWavFormat(Bytes.GetData(), Bytes.Num(), Format);
+		}
+
+		PumpLocked();
+		return !bHadFormat && ParseResult == FusionTts::EParseResult::Parsed && bPlayWhenReady && !Sink;
+	}
+
+	void SetPlayWhenReady(bool bInPlayWhenReady)
+	{
+		FScopeLock ScopeLock(&Lock);
+		bPlayWhenReady = bInPlayWhenReady;
+	}
+
+	bool IsUnsupported() const
+	{
+		FScopeLock ScopeLock(&Lock);
+		return ParseResult == FusionTts::EParseResult::Unsupported;
+	}
+
+	/**
+	 * Game thread. Once the header is parsed, creates the wave, queues everything received so far and keeps feeding it
+	 * as more bytes arrive. Before that it flags the stream so that Append reports the header, all under one lock so
+	 * the header cannot complete in between. Returns null while waiting or when a wave is already attached.
+	 */
+	USoundWaveProcedural* AttachOrWait(TFunctionRef<USoundWaveProcedural*(const FusionTts::FWavFormat&)> CreateWave)
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (Sink || ParseResult == FusionTts::EParseResult::Unsupported)
+		{
+			return nullptr;
+		}
+		if (ParseResult == FusionTts::EParseResult::NeedMoreData)
+		{
+			bPlayWhenReady = true;
+			return nullptr;
+		}
+
+		Sink = CreateWave(Format);
+		SinkOffset = 0;
+		PumpLocked();
+		return Sink;
+	}
+
+	void DetachSink()
+	{
+		FScopeLock ScopeLock(&Lock);
+		Sink = nullptr;
+		bPlayWhenReady = false;
+	}
+
+	/** Game thread, after the request completed. */
+	TSharedPtr<TArray<uint8>, ESPMode::ThreadSafe> TakeBytes()
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		// An attach queued by Append has yet to pump what was received, so the stream keeps its own copy until then.
+		if (bPlayWhenReady && !Sink)
+		{
+			return MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(Bytes);
+		}
+		return MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(MoveTemp(Bytes));
+	}
+
+private:
+	void PumpLocked()
+	{
+		if (!Sink || ParseResult != FusionTts::EParseResult::Parsed)
+		{
+			return;
+		}
+
+		// QueueAudio expects whole frames; a trailing partial frame waits for the next chunk.
+		const int32 BlockAlign = Format.GetBlockAlign();
+		const int64 DataEnd = Format.GetDuration() > 0.f ? FMath::Min<int64>(Bytes.Num(), Format.DataOffset + static_cast<int64>(Format.DataSize)) : Bytes.Num();
+		const int64 Available = DataEnd - Format.DataOffset - SinkOffset;
+		const int32 Queueable = static_cast<int32>(Available - Available % BlockAlign);
+		if (Queueable > 0)
+		{
+			Sink->QueueAudio(Bytes.GetData() + Format.DataOffset + SinkOffset, Queueable);
+			SinkOffset += Queueable;
+		}
+	}
+
+	mutable FCriticalSection Lock;
+	TArray<uint8> Bytes;
+	FusionTts::FWavFormat Format;
+	FusionTts::EParseResult ParseResult = FusionTts::EParseResult::NeedMoreData;
+	bool bPlayWhenReady = false;
+
+	/** Kept alive by UFusionTtsComponent::ActiveWave while attached. */
+	USoundWaveProcedural* Sink = nullptr;
+	int64 SinkOffset = 0;
+};
+
+UFusionTtsComponent::UFusionTtsComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UFusionTtsComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	CacheDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("TtsCache"));
+
+	// Index the disk cache off the game thread; lookups before the scan finishes just miss and download again.
+	TWeakObjectPtr<UFusionTtsComponent> WeakThis = this;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Directory = CacheDirectory]()
+	{
+		TMap<FString, FDiskEntry> Scanned;
+		IFileManager::Get().IterateDirectoryStat(*Directory, [&Scanned](const TCHAR* Path, const FFileStatData& StatData)
+		{
+			if (!StatData.bIsDirectory)
+			{
+				FDiskEntry& Entry = Scanned.Add(FPaths::GetCleanFilename(Path));
+				Entry.Size = StatData.FileSize;
+				Entry.LastUsed = StatData.ModificationTime;
+			}
+			return true;
+		});
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Scanned = MoveTemp(Scanned)]()
+		{
+			if (UFusionTtsComponent* StrongThis = WeakThis.Get())
+			{
+				for (const TPair<FString, FDiskEntry>& Pair : Scanned)
+				{
+					if (!StrongThis->DiskIndex.Contains(Pair.Key))
+					{
+						StrongThis->DiskIndex.Add(Pair.Key, Pair.Value);
+					}
+				}
+			}
+		});
+	});
+}
+
+void UFusionTtsComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopTts();
+
+	if (AFusionMode* FusionMode = Cast<AFusionMode>(GetOwner()))
+	{
+		if (const TSharedPtr<FFusionRequestScheduler> Scheduler = FusionMode->GetRequestScheduler())
+		{
+			// Cancel completes synchronously and removes from ActiveDownloads, so iterate a copy of the keys.
+			TArray<FString> Urls;
+			ActiveDownloads.GetKeys(Urls);
+			for (const FString& Url : Urls)
+			{
+				Scheduler->Cancel(TEXT("tts:") + Url);
+			}
+		}
+	}
+	ActiveDownloads.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UFusionTtsComponent::SetBaseUrl(const FString& InBaseUrl)
+{
+	BaseUrl = InBaseUrl;
+}
+
+FString UFusionTtsComponent::ResolveUrl(const FString& Url) const
+{
+	if (Url.StartsWith(TEXT("http://")) || Url.StartsWith(TEXT("https://")) || BaseUrl.IsEmpty())
+	{
+		return Url;
+	}
+	return BaseUrl / Url;
+}
+
+FString UFusionTtsComponent::GetCacheKey(const FString& ResolvedUrl) const
+{
+	FString Path = ResolvedUrl;
+	int32 QueryIndex = INDEX_NONE;
+	if (Path.FindChar(TEXT('?'), QueryIndex))
+	{
+		Path.LeftInline(QueryIndex);
+	}
+
+	FString Extension = FPaths::GetExtension(Path);
+	if (Extension.IsEmpty() || Extension.Len() > 4)
+	{
+		Extension = TEXT("bin");
+	}
+	return FMD5::HashAnsiString(*ResolvedUrl) + TEXT(".") + Extension;
+}
+
+FString UFusionTtsComponent::GetCacheFilePath(const FString& ResolvedUrl) const
+{
+	return FPaths::Combine(CacheDirectory, GetCacheKey(ResolvedUrl));
+}
+
+bool UFusionTtsComponent::IsTtsCached(const FString& Url) const
+{
+	const FString ResolvedUrl = ResolveUrl(Url);
+	return MemoryCache.Contains(ResolvedUrl) || DiskIndex.Contains(GetCacheKey(ResolvedUrl));
+}
+
+void UFusionTtsComponent::PrefetchTts(const FString& Url)
+{
+	if (Url.IsEmpty())
+	{
+		return;
+	}
+
+	const FString ResolvedUrl = ResolveUrl(Url);
+	if (MemoryCache.Contains(ResolvedUrl) || ActiveDownloads.Contains(ResolvedUrl))
+	{
+		return;
+	}
+
+	if (DiskIndex.Contains(GetCacheKey(ResolvedUrl)))
+	{
+		LoadFromDisk(ResolvedUrl);
+		return;
+	}
+
+	StartDownload(ResolvedUrl, false);
+}
+
+bool UFusionTtsComponent::PlayTts(const FString& Url)
+{
+	if (Url.IsEmpty())
+	{
+		return false;
+	}
+
+	StopTts();
+
+	const FString ResolvedUrl = ResolveUrl(Url);
+	if (MemoryCache.Contains(ResolvedUrl))
+	{
+		return PlayFromMemory(ResolvedUrl);
+	}
+
+	if (const TSharedPtr<FFusionTtsStream, ESPMode::ThreadSafe>* Download = ActiveDownloads.Find(ResolvedUrl))
+	{
+		if ((*Download)->IsUnsupported())
+		{
+			return false;
+		}
+
+		// Promote a speculative prefetch now that the user is actually waiting for it.
+		if (AFusionMode* FusionMode = Cast<AFusionMode>(GetOwner()))
+		{
+			if (const TSharedPtr<FFusionRequestScheduler> Scheduler = FusionMode->GetRequestScheduler())
+			{
+				Scheduler->Promote(TEXT("tts:") + ResolvedUrl, EFusionRequestPriority::Description);
+			}
+		}
+
+		AttachStreamPlayback(*Download);
+		return true;
+	}
+
+	if (DiskIndex.Contains(GetCacheKey(ResolvedUrl)))
+	{
+		PendingPlayUrl = ResolvedUrl;
+		LoadFromDisk(ResolvedUrl);
+		return true;
+	}
+
+	StartDownload(ResolvedUrl, true);
+	return true;
+}
+
+void UFusionTtsComponent::StopTts()
+{
+	if (ActiveStream.IsValid())
+	{
+		ActiveStream->DetachSink();
+		ActiveStream.Reset();
+	}
+
+	if (ActiveAudio)
+	{
+		ActiveAudio->Stop();
+		ActiveAudio = nullptr;
+	}
+
+	ActiveWave = nullptr;
+	PendingPlayUrl.Reset();
+}
+
+void UFusionTtsComponent::StartDownload(const FString& ResolvedUrl, bool bPlayWhenReady)
+{
+	AFusionMode* FusionMode = Cast<AFusionMode>(GetOwner());
+	const TSharedPtr<FFusionRequestScheduler> Scheduler = FusionMode ? FusionMode->GetRequestScheduler() : nullptr;
+	if (!Scheduler.IsValid())
+	{
+		UE_LOG(LogFusionTts, Warning, TEXT("No request scheduler available; cannot download %s"), *ResolvedUrl);
+		return;
+	}
+
+	const TSharedPtr<FFusionTtsStream, ESPMode::ThreadSafe> Stream = MakeShared<FFusionTtsStream, ESPMode::ThreadSafe>(ResolvedUrl);
+	ActiveDownloads.Add(ResolvedUrl, Stream);
+	if (bPlayWhenReady)
+	{
+		ActiveStream = Stream;
+		Stream->SetPlayWhenReady(true);
+	}
+
+	TWeakObjectPtr<UFusionTtsComponent> WeakThis = this;
+
+	FFusionRequestJob Job;
+	Job.Key = TEXT("tts:") + ResolvedUrl;
+	Job.Url = ResolvedUrl;
+	Job.EndpointKey = FusionTts::GetServerKey(ResolvedUrl);
+	Job.Priority = bPlayWhenReady ? EFusionRequestPriority::Description : EFusionRequestPriority::Speculative;
+	Job.DeadlineSeconds = DownloadDeadlineSeconds;
+	Job.ConfigureRequest = [Stream, WeakThis](const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request)
+	{
+		Request->SetVerb(TEXT("GET"));
+		Request->SetResponseBodyReceiveStreamDelegateV2(FHttpRequestStreamDelegateV2::CreateLambda([Stream, WeakThis](void* Ptr, int64& Length)
+		{
+			if (Stream->Append(static_cast<const uint8*>(Ptr), Length))
+			{
+				AsyncTask(ENamedThreads::GameThread, [Stream, WeakThis]()
+				{
+					UFusionTtsComponent* StrongThis = WeakThis.Get();
+					if (StrongThis && StrongThis->ActiveStream == Stream)
+					{
+						StrongThis->AttachStreamPlayback(Stream);
+					}
+				});
+			}
+		}));
+	};
+	Job.OnComplete = [WeakThis, ResolvedUrl](FHttpResponsePtr Response, EFusionRequestOutcome Outcome)
+	{
+		if (UFusionTtsComponent* StrongThis = WeakThis.Get())
+		{
+			const bool bSucceeded = Outcome == EFusionRequestOutcome::Succeeded && Response.IsValid() && EHttpResponseCodes::IsOk(Response->GetResponseCode());
+			StrongThis->HandleDownloadComplete(ResolvedUrl, bSucceeded);
+		}
+	};
+
+	Scheduler->Enqueue(MoveTemp(Job));
+}
+
+void UFusionTtsComponent::HandleDownloadComplete(const FString& ResolvedUrl, bool bSucceeded)
+{
+	TSharedPtr<FFusionTtsStream, ESPMode::ThreadSafe> Stream;
+	ActiveDownloads.RemoveAndCopyValue(ResolvedUrl, Stream);
+	if (!Stream.IsValid())
+	{
+		return;
+	}
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogFusionTts, Warning, TEXT("TTS download failed: %s"), *ResolvedUrl);
+		return;
+	}
+
+	const TSharedPtr<TArray<uint8>, ESPMode::ThreadSafe> Data = Stream->TakeBytes();
+	AddToMemoryCache(ResolvedUrl, Data);
+	WriteToDiskCache(ResolvedUrl, Data);
+}
+
+void UFusionTtsComponent::LoadFromDisk(const FString& ResolvedUrl)
+{
+	const FString FilePath = GetCacheFilePath(ResolvedUrl);
+	if (FDiskEntry* Entry = DiskIndex.Find(GetCacheKey(ResolvedUrl)))
+	{
+		Entry->LastUsed = FDateTime::UtcNow();
+	}
+
+	TWeakObjectPtr<UFusionTtsComponent> WeakThis = this;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, ResolvedUrl, FilePath]()
+	{
+		const TSharedPtr<TArray<uint8>, ESPMode::ThreadSafe> Data = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+		const bool bLoaded = FFileHelper::LoadFileToArray(*Data, *FilePath, FILEREAD_Silent);
+		if (bLoaded)
+		{
+			// Touch the file so the disk eviction order survives restarts.
+			IFileManager::Get().SetTimeStamp(*FilePath, FDateTime::UtcNow());
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, ResolvedUrl, FilePath, Data, bLoaded]()
+		{
+			UFusionTtsComponent* StrongThis = WeakThis.Get();
+			if (!StrongThis)
+			{
+				return;
+			}
+
+			if (!bLoaded)
+			{
+				StrongThis->DiskIndex.Remove(StrongThis->GetCacheKey(ResolvedUrl));
+				if (StrongThis->PendingPlayUrl == ResolvedUrl)
+				{
+					StrongThis->PendingPlayUrl.Reset();
+					StrongThis->StartDownload(ResolvedUrl, true);
+				}
+				return;
+			}
+
+			StrongThis->AddToMemoryCache(ResolvedUrl, Data);
+			StrongThis->OnTtsAudioCached.Broadcast(ResolvedUrl, FilePath);
+
+			if (StrongThis->PendingPlayUrl == ResolvedUrl)
+			{
+				StrongThis->PendingPlayUrl.Reset();
+				StrongThis->PlayFromMemory(ResolvedUrl);
+			}
+		});
+	});
+}
+
+void UFusionTtsComponent::AddToMemoryCache(const FString& ResolvedUrl, const TSharedPtr<TArray<uint8>, ESPMode::ThreadSafe>& Data)
+{
+	if (FMemoryEntry* Existing = MemoryCache.Find(ResolvedUrl))
+	{
+		MemoryCacheBytes -= Existing->Data->Num();
+	}
+
+	FMemoryEntry& Entry = MemoryCache.Add(ResolvedUrl);
+	Entry.Data = Data;
+	Entry.LastUsed = FPlatformTime::Seconds();
+	MemoryCacheBytes += Data->Num();
+
+	TrimMemoryCache();
+}
+
+void UFusionTtsComponent::TrimMemoryCache()
+{
+	const int64 Budget = static_cast<int64>(MemoryCacheMegabytes) * 1024 * 1024;
+	while (MemoryCacheBytes > Budget && MemoryCache.Num() > 0)
+	{
+		const FString* Oldest = nullptr;
+		double OldestTime = TNumericLimits<double>::Max();
+		for (const TPair<FString, FMemoryEntry>& Pair : MemoryCache)
+		{
+			if (Pair.Value.LastUsed < OldestTime)
+			{
+				OldestTime = Pair.Value.LastUsed;
+				Oldest = &Pair.Key;
+			}
+		}
+
+		const FString EvictedUrl = *Oldest;
+		MemoryCacheBytes -= MemoryCache[EvictedUrl].Data->Num();
+		MemoryCache.Remove(EvictedUrl);
+	}
+}
+
+void UFusionTtsComponent::WriteToDiskCache(const FString& ResolvedUrl, const TSharedPtr<TArray<uint8>, ESPMode::ThreadSafe>& Data)
+{
+	const int64 Budget = static_cast<int64>(DiskCacheMegabytes) * 1024 * 1024;
+	if (Data->Num() > Budget)
+	{
+		OnTtsAudioCached.Broadcast(ResolvedUrl, FString());
+		return;
+	}
+
+	const FString Key = GetCacheKey(ResolvedUrl);
+	FDiskEntry& NewEntry = DiskIndex.FindOrAdd(Key);
+	NewEntry.Size = Data->Num();
+	NewEntry.LastUsed = FDateTime::UtcNow();
+
+	// Decide evictions here so the index stays authoritative; the file operations happen on a worker.
+	int64 TotalBytes = 0;
+	for (const TPair<FString, FDiskEntry>& Pair : DiskIndex)
+	{
+		TotalBytes += Pair.Value.Size;
+	}
+
+	TArray<FString> Evicted;
+	while (TotalBytes > Budget)
+	{
+		const FString* Oldest = nullptr;
+		for (const TPair<FString, FDiskEntry>& Pair : DiskIndex)
+		{
+			if (Pair.Key != Key && (!Oldest || Pair.Value.LastUsed < DiskIndex[*Oldest].LastUsed))
+			{
+				Oldest = &Pair.Key;
+			}
+		}
+		if (!Oldest)
+		{
+			break;
+		}
+
+		const FString EvictedKey = *Oldest;
+		TotalBytes -= DiskIndex[EvictedKey].Size;
+		DiskIndex.Remove(EvictedKey);
+		Evicted.Add(FPaths::Combine(CacheDirectory, EvictedKey));
+	}
+
+	TWeakObjectPtr<UFusionTtsComponent> WeakThis = this;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, ResolvedUrl, Key, Data, FilePath = GetCacheFilePath(ResolvedUrl), Directory = CacheDirectory, Evicted = MoveTemp(Evicted)]()
+	{
+		IFileManager::Get().MakeDirectory(*Directory, true);
+		const bool bSaved = FFileHelper::SaveArrayToFile(*Data, *FilePath);
+		if (!bSaved)
+		{
+			UE_LOG(LogFusionTts, Warning, TEXT("Failed to write TTS cache file %s"), *FilePath);
+		}
+
+		for (const FString& EvictedPath : Evicted)
+		{
+			IFileManager::Get().Delete(*EvictedPath, false, false, true);
+		}
+
+		// Listeners may open the file right away, so they only hear about it once it is complete.
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, ResolvedUrl, Key, FilePath, bSaved]()
+		{
+			UFusionTtsComponent* StrongThis = WeakThis.Get();
+			if (!StrongThis)
+			{
+				return;
+			}
+
+			if (!bSaved)
+			{
+				StrongThis->DiskIndex.Remove(Key);
+			}
+			StrongThis->OnTtsAudioCached.Broadcast(ResolvedUrl, bSaved ? FilePath : FString());
+		});
+	});
+}
+
+bool UFusionTtsComponent::PlayFromMemory(const FString& ResolvedUrl)
+{
+	FMemoryEntry* Entry = MemoryCache.Find(ResolvedUrl);
+	if (!Entry)
+	{
+		return false;
+	}
+	Entry->LastUsed = FPlatformTime::Seconds();
+
+	const TArray<uint8>& Data = *Entry->Data;
+	FusionTts::FWavFormat Format;
+	if (FusionTts::ParseWavFormat(Data.GetData(), Data.Num(), Format) != FusionTts::EParseResult::Parsed)
+	{
+		return false;
+	}
+
+	const int64 DataEnd = Format.GetDuration() > 0.f ? FMath::Min<int64>(Data.Num(), Format.DataOffset + static_cast<int64>(Format.DataSize)) : Data.Num();
+	const int64 Available = DataEnd - Format.DataOffset;
+	const int32 Queueable = static_cast<int32>(Available - Available % Format.GetBlockAlign());
+
+	USoundWaveProcedural* Wave = CreateProceduralWave(Format.SampleRate, Format.NumChannels, static_cast<float>(Queueable) / (Format.SampleRate * Format.GetBlockAlign()));
+	if (Queueable > 0)
+	{
+		Wave->QueueAudio(Data.GetData() + Format.DataOffset, Queueable);
+	}
+
+	StartPlayback(Wave);
+	return true;
+}
+
+void UFusionTtsComponent::AttachStreamPlayback(const TSharedPtr<FFusionTtsStream, ESPMode::ThreadSafe>& Stream)
+{
+	ActiveStream = Stream;
+
+	// Without the header yet, the HTTP thread calls back once it is here.
+	USoundWaveProcedural* Wave = Stream->AttachOrWait([this](const FusionTts::FWavFormat& Format)
+	{
+		return CreateProceduralWave(Format.SampleRate, Format.NumChannels, Format.GetDuration());
+	});
+	if (Wave)
+	{
+		StartPlayback(Wave);
+	}
+}
+
+USoundWaveProcedural* UFusionTtsComponent::CreateProceduralWave(int32 SampleRate, int32 NumChannels, float Duration)
+{
+	USoundWaveProcedural* Wave = NewObject<USoundWaveProcedural>(this);
+	Wave->SetSampleRate(SampleRate);
+	Wave->NumChannels = NumChannels;
+	Wave->Duration = Duration > 0.f ? Duration : INDEFINITELY_LOOPING_DURATION;
+	Wave->SoundGroup = SOUNDGROUP_Voice;
+	Wave->bLooping = false;
+	return Wave;
+}
+
+void UFusionTtsComponent::StartPlayback(USoundWaveProcedural* Wave)
+{
+	ActiveWave = Wave;
+	ActiveAudio = UGameplayStatics::CreateSound2D(this, Wave);
+	if (ActiveAudio)
+	{
+		ActiveAudio->Play();
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "FusionTtsComponent.generated.h"
+
+class UAudioComponent;
+class USoundWaveProcedural;
+class FFusionTtsStream;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTtsAudioCached, const FString&, Url, const FString&, CachedFilePath);
+
+/**
+ * Downloads description TTS audio as soon as its URL is known, keeps it in a size-bounded memory and disk cache,
+ * and plays 16-bit PCM wav responses through a procedural sound wave that starts with the first received bytes.
+ * Other formats are cached and handed to Blueprint through OnTtsAudioCached.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class FUSION_API UFusionTtsComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UFusionTtsComponent();
+
+	/** Starts a low-priority download unless the audio is already cached or downloading. */
+	UFUNCTION(BlueprintCallable, Category="Fusion|TTS")
+	void PrefetchTts(const FString& Url);
+
+	/** Plays cached audio immediately or streams it while it downloads. Returns false for formats that cannot be streamed. */
+	UFUNCTION(BlueprintCallable, Category="Fusion|TTS")
+	bool PlayTts(const FString& Url);
+
+	UFUNCTION(BlueprintCallable, Category="Fusion|TTS")
+	void StopTts();
+
+	UFUNCTION(BlueprintCallable, Category="Fusion|TTS")
+	bool IsTtsCached(const FString& Url) const;
+
+	/** Prefix used for relative tts_url values such as "/tts/colobus.wav". */
+	void SetBaseUrl(const FString& InBaseUrl);
+
+	/**
+	 * Broadcast once downloaded audio is in the cache, after its file has been completely written. CachedFilePath is
+	 * empty when the clip is kept in memory only, because it exceeds the disk budget or could not be written.
+	 */
+	UPROPERTY(BlueprintAssignable, Category="Fusion|TTS")
+	FOnTtsAudioCached OnTtsAudioCached;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	struct FMemoryEntry
+	{
+		TSharedPtr<TArray<uint8>, ESPMode::ThreadSafe> Data;
+		double LastUsed = 0.0;
+	};
+
+	struct FDiskEntry
+	{
+		int64 Size = 0;
+		FDateTime LastUsed;
+	};
+
+	FString ResolveUrl(const FString& Url) const;
+	FString GetCacheKey(const FString& ResolvedUrl) const;
+	FString GetCacheFilePath(const FString& ResolvedUrl) const;
+
+	void StartDownload(const FString& ResolvedUrl, bool bPlayWhenReady);
+	void HandleDownloadComplete(const FString& ResolvedUrl, bool bSucceeded);
+	void LoadFromDisk(const FString& ResolvedUrl);
+	void AddToMemoryCache(const FString& ResolvedUrl, const TSharedPtr<TArray<uint8>, ESPMode::ThreadSafe>& Data);
+	void WriteToDiskCache(const FString& ResolvedUrl, const TSharedPtr<TArray<uint8>, ESPMode::ThreadSafe>& Data);
+	void TrimMemoryCache();
+
+	bool PlayFromMemory(const FString& ResolvedUrl);
+	void AttachStreamPlayback(const TSharedPtr<FFusionTtsStream, ESPMode::ThreadSafe>& Stream);
+	USoundWaveProcedural* CreateProceduralWave(int32 SampleRate, int32 NumChannels, float Duration);
+	void StartPlayback(USoundWaveProcedural* Wave);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Fusion|TTS", meta=(ClampMin="0", AllowPrivateAccess="true"))
+	int32 MemoryCacheMegabytes = 16;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Fusion|TTS", meta=(ClampMin="0", AllowPrivateAccess="true"))
+	int32 DiskCacheMegabytes = 128;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Fusion|TTS", meta=(ClampMin="0.0", AllowPrivateAccess="true"))
+	float DownloadDeadlineSeconds = 20.f;
+
+	FString BaseUrl;
+	FString CacheDirectory;
+
+	TMap<FString, FMemoryEntry> MemoryCache;
+	int64 MemoryCacheBytes = 0;
+
+	/** Keyed by cache file name; filled by a background directory scan at BeginPlay. */
+	TMap<FString, FDiskEntry> DiskIndex;
+
+	TMap<FString, TSharedPtr<FFusionTtsStream, ESPMode::ThreadSafe>> ActiveDownloads;
+
+	/** Url waiting for a disk load or non-streamable download before it can play. */
+	FString PendingPlayUrl;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UAudioComponent> ActiveAudio;
+
+	UPROPERTY(Transient)
+	TObjectPtr<USoundWaveProcedural> ActiveWave;
+
+	TSharedPtr<FFusionTtsStream, ESPMode::ThreadSafe> ActiveStream;
+};
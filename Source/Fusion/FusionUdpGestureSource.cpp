@@ -0,0 +1,232 @@
+#include "FusionUdpGestureSource.h"
+
+#include "Common/UdpSocketBuilder.h"
+#include "Dom/JsonObject.h"
+#include "FusionGestureSequenceTracker.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFusionUdp, Log, All);
+
+namespace
+{
+    constexpr double OpenRetrySeconds = 1.0;
+
+    /** Without datagrams for this long the sender is reported as disconnected. */
+    constexpr double ConnectedTimeoutSeconds = 1.0;
+
+    constexpr int32 MaxDatagramSize = 65507;
+
+    /** Kept small on purpose: whatever the kernel buffers is already late by the time it is read. */
+    constexpr int32 ReceiveBufferBytes = 64 * 1024;
+}
+
+FFusionUdpGestureSource::FFusionUdpGestureSource(const FString& InBindAddress, int32 InPort)
+    : BindAddress(InBindAddress)
+    , Port(InPort)
+{
+    Stats.Transport = GetName();
+}
+
+FFusionUdpGestureSource::~FFusionUdpGestureSource()
+{
+    CloseSocket();
+}
+
+void FFusionUdpGestureSource::Poll(TArray<FFusionGestureFrame>& OutFrames)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (!Socket)
+    {
+        if (Now < NextOpenTime)
+        {
+            return;
+        }
+        NextOpenTime = Now + OpenRetrySeconds;
+        if (!OpenSocket())
+        {
+            return;
+        }
+    }
+
+    Candidate.Reset();
+    CandidateRange = FSequenceRange();
+
+    // Frames of this poll that were newer than the last delivered frame but lost to a newer datagram; not gaps.
+    int64 DroppedAhead = 0;
+
+    uint32 PendingSize = 0;
+    while (Socket->HasPendingData(PendingSize))
+    {
+        ReceiveBuffer.SetNumUninitialized(MaxDatagramSize + 1, EAllowShrinking::No);
+        int32 BytesRead = 0;
+        if (!Socket->Recv(ReceiveBuffer.GetData(), MaxDatagramSize, BytesRead) || BytesRead <= 0)
+        {
+            break;
+        }
+        ReceiveBuffer.SetNum(BytesRead + 1, EAllowShrinking::No);
+        ReceiveBuffer[BytesRead] = 0;
+        LastReceiveTime = Now;
+
+        // A batch is only stale when even its newest frame was delivered already.
+        const FSequenceRange Range = ScanSequences(reinterpret_cast<const ANSICHAR*>(ReceiveBuffer.GetData()));
+        Stats.FramesReceived += Range.NumFrames();
+        if (Range.Last != INDEX_NONE && LastDeliveredSequence != INDEX_NONE && Range.Last <= LastDeliveredSequence)
+        {
+            if (LastDeliveredSequence - Range.Last < FFusionGestureSequenceTracker::RestartDistance)
+            {
+                Stats.FramesReordered += Range.NumFrames();
+                continue;
+            }
+            UE_LOG(LogFusionUdp, Log, TEXT("Gesture sender on port %d restarted its sequence (%lld after %lld)"), Port, Range.Last, LastDeliveredSequence);
+            LastDeliveredSequence = INDEX_NONE;
+        }
+
+        if (Candidate.Num() > 0)
+        {
+            const bool bOlderThanCandidate = Range.Last != INDEX_NONE && CandidateRange.Last != INDEX_NONE
+                && Range.Last < CandidateRange.Last && CandidateRange.Last - Range.Last < FFusionGestureSequenceTracker::RestartDistance;
+            const FSequenceRange& Dropped = bOlderThanCandidate ? Range : CandidateRange;
+            Stats.FramesSuperseded += Dropped.NumFrames();
+            DroppedAhead += Dropped.NumNewerThan(LastDeliveredSequence);
+            if (bOlderThanCandidate)
+            {
+                continue;
+            }
+        }
+
+        Swap(Candidate, ReceiveBuffer);
+        CandidateRange = Range;
+    }
+
+    if (Candidate.Num() == 0)
+    {
+        return;
+    }
+
+    // Frames between the last delivered one and the candidate's oldest that no datagram of this poll carried.
+    if (CandidateRange.First != INDEX_NONE && LastDeliveredSequence != INDEX_NONE)
+    {
+        Stats.FramesLost += static_cast<int32>(FMath::Max<int64>(0, CandidateRange.First - LastDeliveredSequence - 1 - DroppedAhead));
+    }
+
+    DeliverCandidate(OutFrames);
+}
+
+void FFusionUdpGestureSource::DeliverCandidate(TArray<FFusionGestureFrame>& OutFrames)
+{
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Candidate.GetData()), Candidate.Num() - 1);
+    const FString Text(Converted.Length(), Converted.Get());
+
+    TSharedPtr<FJsonObject> JsonPayload;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+    if (!FJsonSerializer::Deserialize(Reader, JsonPayload) || !JsonPayload.IsValid())
+    {
+        ++Stats.FramesMalformed;
+        return;
+    }
+
+    TArray<FFusionGestureFrame> Frames;
+    FusionGestureJson::ParseFrames(*JsonPayload, Frames);
+    for (FFusionGestureFrame& Frame : Frames)
+    {
+        // Batches overlap when the sender repeats recent frames; only the part past the last delivered frame is new.
+        if (Frame.Sequence != INDEX_NONE && LastDeliveredSequence != INDEX_NONE && Frame.Sequence <= LastDeliveredSequence)
+        {
+            continue;
+        }
+        if (Frame.Sequence != INDEX_NONE)
+        {
+            LastDeliveredSequence = Frame.Sequence;
+        }
+        ++Stats.FramesDelivered;
+        OutFrames.Add(MoveTemp(Frame));
+    }
+}
+
+FFusionUdpGestureSource::FSequenceRange FFusionUdpGestureSource::ScanSequences(const ANSICHAR* Text)
+{
+    FSequenceRange Range;
+    for (const ANSICHAR* Key = FCStringAnsi::Strstr(Text, "\"seq\""); Key; Key = FCStringAnsi::Strstr(Key + 5, "\"seq\""))
+    {
+        const ANSICHAR* Value = Key + 5;
+        while (*Value == ' ' || *Value == '\t' || *Value == ':')
+        {
+            ++Value;
+        }
+        if (!FChar::IsDigit(static_cast<TCHAR>(*Value)))
+        {
+            continue;
+        }
+
+        const int64 Sequence = FCStringAnsi::Strtoi64(Value, nullptr, 10);
+        if (Range.Count == 0)
+        {
+            Range.First = Sequence;
+        }
+        Range.Last = Sequence;
+        ++Range.Count;
+    }
+    return Range;
+}
+
+int32 FFusionUdpGestureSource::FSequenceRange::NumNewerThan(int64 Sequence) const
+{
+    if (Last == INDEX_NONE || Sequence == INDEX_NONE)
+    {
+        return NumFrames();
+    }
+    return static_cast<int32>(FMath::Clamp<int64>(Last - Sequence, 0, Count));
+}
+
+bool FFusionUdpGestureSource::IsConnected() const
+{
+    return Socket != nullptr && LastReceiveTime > 0.0 && FPlatformTime::Seconds() - LastReceiveTime < ConnectedTimeoutSeconds;
+}
+
+FFusionGestureTransportStats FFusionUdpGestureSource::GetStats() const
+{
+    FFusionGestureTransportStats Result = Stats;
+    Result.bConnected = IsConnected();
+    return Result;
+}
+
+bool FFusionUdpGestureSource::OpenSocket()
+{
+    // Frames carry clicks, so only the configured interface may send them, and the port is not shared with other processes.
+    FIPv4Address Address = FIPv4Address::InternalLoopback;
+    if (!BindAddress.IsEmpty() && !FIPv4Address::Parse(BindAddress, Address))
+    {
+        UE_LOG(LogFusionUdp, Warning, TEXT("Invalid gesture UDP bind address '%s'; listening on loopback"), *BindAddress);
+        Address = FIPv4Address::InternalLoopback;
+    }
+
+    const FIPv4Endpoint Endpoint(Address, static_cast<uint16>(Port));
+    Socket = FUdpSocketBuilder(TEXT("FusionGestureUdp"))
+        .AsNonBlocking()
+        .BoundToEndpoint(Endpoint)
+        .WithReceiveBufferSize(ReceiveBufferBytes)
+        .Build();
+
+    if (!Socket)
+    {
+        UE_LOG(LogFusionUdp, Warning, TEXT("Could not bind gesture UDP port %d; retrying"), Port);
+        return false;
+    }
+
+    UE_LOG(LogFusionUdp, Verbose, TEXT("Listening for gesture datagrams on %s"), *Endpoint.ToString());
+    return true;
+}
+
+void FFusionUdpGestureSource::CloseSocket()
+{
+    if (Socket)
+    {
+        Socket->Close();
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+        Socket = nullptr;
+    }
+}
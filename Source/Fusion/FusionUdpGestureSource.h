@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FusionGestureSource.h"
+
+class FSocket;
+
+/**
+ * Receives gesture frames as UDP datagrams, one JSON frame per datagram in the WebSocket format with its "seq"
+ * counter. Nothing is queued: each poll drains the socket and delivers only the newest frame, and frames older than
+ * one already delivered are dropped. Only that newest datagram is JSON-parsed; the others are ordered by a scan for
+ * "seq". Datagrams without "seq" are taken in arrival order. A datagram holding a "frames" batch is ordered by its
+ * last (newest) frame, so a batch that repeats recent frames still counts as new, and its frames newer than the last
+ * delivered one are all delivered, oldest first. Transport stats count frames, not datagrams.
+ */
+class FUSION_API FFusionUdpGestureSource : public IFusionGestureSource
+{
+public:
+    /** Listens on InBindAddress, an IPv4 address; "0.0.0.0" accepts frames from any host on the network. */
+    FFusionUdpGestureSource(const FString& InBindAddress, int32 InPort);
+    virtual ~FFusionUdpGestureSource() override;
+
+    virtual void Poll(TArray<FFusionGestureFrame>& OutFrames) override;
+
+    /** True while datagrams keep arriving. */
+    virtual bool IsConnected() const override;
+
+    virtual const TCHAR* GetName() const override { return TEXT("Udp"); }
+
+    /**
+     * A frame arriving after its gap was counted as lost stays lost and is counted as reordered as well. Duplicated
+     * datagrams count as reordered.
+     */
+    virtual FFusionGestureTransportStats GetStats() const override;
+
+private:
+    bool OpenSocket();
+    void CloseSocket();
+
+    /** "seq" values of a datagram: oldest and newest frame, INDEX_NONE without any, and how many frames carry one. */
+    struct FSequenceRange
+    {
+        int64 First = INDEX_NONE;
+        int64 Last = INDEX_NONE;
+        int32 Count = 0;
+
+        /** Frames in the datagram; one for a datagram without "seq". */
+        int32 NumFrames() const { return FMath::Max(1, Count); }
+
+        /** Frames newer than Sequence, assuming the batch numbers its frames consecutively. */
+        int32 NumNewerThan(int64 Sequence) const;
+    };
+
+    /** Scans a NUL-terminated datagram for its "seq" values without parsing it. */
+    static FSequenceRange ScanSequences(const ANSICHAR* Text);
+
+    void DeliverCandidate(TArray<FFusionGestureFrame>& OutFrames);
+
+    FString BindAddress;
+    int32 Port = 0;
+    FSocket* Socket = nullptr;
+    double NextOpenTime = 0.0;
+    double LastReceiveTime = 0.0;
+
+    /** Receive buffer, and the newest datagram of the current poll with its sequence. */
+    TArray<uint8> ReceiveBuffer;
+    TArray<uint8> Candidate;
+    FSequenceRange CandidateRange;
+
+    int64 LastDeliveredSequence = INDEX_NONE;
+
+    FFusionGestureTransportStats Stats;
+};
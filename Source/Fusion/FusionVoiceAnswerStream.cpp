@@ -0,0 +1,193 @@
+#include "FusionVoiceAnswerStream.h"
+
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+
+namespace FusionVoiceAnswerStream
+{
+    static FString DecodeUtf8(const uint8* Data, int32 Length)
+    {
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Length);
+        return FString(Converted.Length(), Converted.Get());
+    }
+}
+
+bool FFusionVoiceAnswerStream::AppendBytes(const uint8* Data, int64 Length)
+{
+    if (!Data || Length <= 0)
+    {
+        return false;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    Buffer.Append(Data, static_cast<int32>(Length));
+
+    if (Mode == EMode::Unknown)
+    {
+        // SSE bodies start with a field name or a comment; JSON starts with '{' or '['.
+        for (const uint8 Byte : Buffer)
+        {
+            if (FChar::IsWhitespace(static_cast<TCHAR>(Byte)))
+            {
+                continue;
+            }
+            Mode = (Byte == '{' || Byte == '[') ? EMode::Raw : EMode::EventStream;
+            break;
+        }
+    }
+
+    if (Mode != EMode::EventStream)
+    {
+        return false;
+    }
+
+    const int32 PreviousCount = PendingEvents.Num();
+    ParseLinesLocked(false);
+    return PendingEvents.Num() > PreviousCount;
+}
+
+void FFusionVoiceAnswerStream::Finish()
+{
+    FScopeLock ScopeLock(&Lock);
+    if (Mode == EMode::EventStream)
+    {
+        ParseLinesLocked(true);
+        DispatchEventLocked();
+    }
+}
+
+void FFusionVoiceAnswerStream::DrainEvents(TArray<FEvent>& OutEvents)
+{
+    FScopeLock ScopeLock(&Lock);
+    OutEvents = MoveTemp(PendingEvents);
+    PendingEvents.Reset();
+}
+
+bool FFusionVoiceAnswerStream::IsEventStream() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Mode == EMode::EventStream;
+}
+
+FString FFusionVoiceAnswerStream::GetRawBody() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return FusionVoiceAnswerStream::DecodeUtf8(Buffer.GetData(), Buffer.Num());
+}
+
+void FFusionVoiceAnswerStream::ParseLinesLocked(bool bFlush)
+{
+    int32 LineStart = ParseOffset;
+    for (int32 Index = ParseOffset; Index <= Buffer.Num(); ++Index)
+    {
+        const bool bEndOfBuffer = Index == Buffer.Num();
+        if (bEndOfBuffer && (!bFlush || LineStart == Index))
+        {
+            break;
+        }
+        if (!bEndOfBuffer && Buffer[Index] != '\n')
+        {
+            continue;
+        }
+
+        int32 LineEnd = Index;
+        if (LineEnd > LineStart && Buffer[LineEnd - 1] == '\r')
+        {
+            --LineEnd;
+        }
+
+        const FString Line = FusionVoiceAnswerStream::DecodeUtf8(Buffer.GetData() + LineStart, LineEnd - LineStart);
+        LineStart = Index + 1;
+
+        if (Line.IsEmpty())
+        {
+            DispatchEventLocked();
+            continue;
+        }
+        if (Line.StartsWith(TEXT(":")))
+        {
+            continue;
+        }
+
+        FString Field = Line;
+        FString Value;
+        int32 ColonIndex = INDEX_NONE;
+        if (Line.FindChar(TEXT(':'), ColonIndex))
+        {
+            Field = Line.Left(ColonIndex);
+            Value = Line.Mid(ColonIndex + 1);
+            if (Value.StartsWith(TEXT(" ")))
+            {
+                Value.RightChopInline(1);
+            }
+        }
+
+        if (Field == TEXT("data"))
+        {
+            if (bHasEventData)
+            {
+                EventData.AppendChar(TEXT('\n'));
+            }
+            EventData.Append(Value);
+            bHasEventData = true;
+        }
+        else if (Field == TEXT("event"))
+        {
+            EventName = Value;
+        }
+    }
+
+    // Drop consumed bytes once in a while so the buffer does not grow for the whole answer.
+    ParseOffset = FMath::Min(LineStart, Buffer.Num());
+    if (ParseOffset > 4096)
+    {
+        Buffer.RemoveAt(0, ParseOffset);
+        ParseOffset = 0;
+    }
+}
+
+void FFusionVoiceAnswerStream::DispatchEventLocked()
+{
+    if (!bHasEventData)
+    {
+        EventName.Reset();
+        return;
+    }
+
+    const FString Data = MoveTemp(EventData);
+    const FString Name = MoveTemp(EventName);
+    EventData.Reset();
+    EventName.Reset();
+    bHasEventData = false;
+
+    if (Data == TEXT("[DONE]"))
+    {
+        return;
+    }
+
+    TSharedPtr<FJsonObject> JsonPayload;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Data);
+    if (!Data.StartsWith(TEXT("{")) || !FJsonSerializer::Deserialize(Reader, JsonPayload) || !JsonPayload.IsValid())
+    {
+        FEvent& Event = PendingEvents.AddDefaulted_GetRef();
+        Event.Type = Name == TEXT("question") ? EEventType::Question : Name == TEXT("answer") ? EEventType::Answer : EEventType::Token;
+        Event.Text = Data;
+        return;
+    }
+
+    FString Text;
+    if (JsonPayload->TryGetStringField(TEXT("user_question"), Text) || JsonPayload->TryGetStringField(TEXT("question"), Text))
+    {
+        PendingEvents.Add({ EEventType::Question, Text });
+    }
+    if (JsonPayload->TryGetStringField(TEXT("token"), Text) || JsonPayload->TryGetStringField(TEXT("delta"), Text))
+    {
+        PendingEvents.Add({ EEventType::Token, Text });
+    }
+    if (JsonPayload->TryGetStringField(TEXT("llm_result"), Text) || JsonPayload->TryGetStringField(TEXT("answer"), Text))
+    {
+        PendingEvents.Add({ EEventType::Answer, Text });
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Incremental parser for the voice endpoint's response body. Bytes arrive on the HTTP thread; a server-sent-events
+ * body is split into question/token/answer events as soon as each event is complete, anything else is buffered
+ * untouched so the caller can fall back to parsing the whole JSON document on completion.
+ */
+class FUSION_API FFusionVoiceAnswerStream
+{
+public:
+    enum class EEventType : uint8
+    {
+        Question,
+        Token,
+        Answer
+    };
+
+    struct FEvent
+    {
+        EEventType Type = EEventType::Token;
+        FString Text;
+    };
+
+    /** HTTP thread. Returns true when new events became available. */
+    bool AppendBytes(const uint8* Data, int64 Length);
+
+    /** Flushes a trailing event that was not terminated by a blank line. */
+    void Finish();
+
+    /** Game thread. Moves all parsed events out in arrival order. */
+    void DrainEvents(TArray<FEvent>& OutEvents);
+
+    bool IsEventStream() const;
+
+    /** Full body for non-SSE responses. */
+    FString GetRawBody() const;
+
+private:
+    enum class EMode : uint8
+    {
+        Unknown,
+        EventStream,
+        Raw
+    };
+
+    void ParseLinesLocked(bool bFlush);
+    void DispatchEventLocked();
+
+    mutable FCriticalSection Lock;
+    TArray<uint8> Buffer;
+    int32 ParseOffset = 0;
+    EMode Mode = EMode::Unknown;
+
+    FString EventName;
+    FString EventData;
+    bool bHasEventData = false;
+
+    TArray<FEvent> PendingEvents;
+};
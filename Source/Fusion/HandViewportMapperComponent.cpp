@@ -11,6 +11,7 @@
 
 #include "InputActionValue.h"
 #include "InteractableWidget.h"
+#include "InteractableWidgetSubsystem.h"
 #include "Blueprint/WidgetLayoutLibrary.h"
 #include "Engine/Engine.h"
 #include "Engine/GameViewportClient.h"
@@ -18,12 +19,70 @@
 #include "Widgets/SWindow.h"
 #include "Slate/SObjectWidget.h"
 #include "Framework/Application/SlateApplication.h"
+#include "Framework/Application/SlateUser.h"
 #include "Huxley/CameraManager.h"
 #include "Huxley/FusionPlayerController.h"
 #include "Kismet/GameplayStatics.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogHandViewportMapper, Log, All);
 
+namespace
+{
+	const FName ObjectWidgetType(TEXT("SObjectWidget"));
+
+	/** Hand pointers use virtual users from here on, clear of widget interaction components' default of 0. */
+	constexpr int32 FirstHandVirtualUser = 8;
+
+	/** Desktop position outside every window, where a pointer goes to leave whatever it hovers. */
+	const FVector2D OffscreenPointerPosition(-100000.0, -100000.0);
+
+	FPointerEvent MakeHandPointerEvent(int32 UserIndex, const FVector2D& ScreenPosition, const FVector2D& LastScreenPosition, bool bPressed, const FKey& EffectingButton)
+	{
+		TSet<FKey> PressedButtons;
+		if (bPressed)
+		{
+			PressedButtons.Add(EKeys::LeftMouseButton);
+		}
+		return FPointerEvent(UserIndex, FSlateApplicationBase::CursorPointerIndex, ScreenPosition, LastScreenPosition, PressedButtons, EffectingButton, 0.f, FModifierKeysState());
+	}
+
+	/** Slab test: distance along the unit Direction where the ray enters Bounds, 0 when it starts inside. */
+	bool IntersectRayBox(const FVector2D& Origin, const FVector2D& Direction, const FBox2D& Bounds, double MaxDistance, double& OutDistance)
+	{
+		double Enter = 0.0;
+		double Exit = MaxDistance;
+		for (int32 Axis = 0; Axis < 2; ++Axis)
+		{
+			if (FMath::IsNearlyZero(Direction[Axis]))
+			{
+				if (Origin[Axis] < Bounds.Min[Axis] || Origin[Axis] > Bounds.Max[Axis])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const double InverseDirection = 1.0 / Direction[Axis];
+			double Near = (Bounds.Min[Axis] - Origin[Axis]) * InverseDirection;
+			double Far = (Bounds.Max[Axis] - Origin[Axis]) * InverseDirection;
+			if (Near > Far)
+			{
+				Swap(Near, Far);
+			}
+
+			Enter = FMath::Max(Enter, Near);
+			Exit = FMath::Min(Exit, Far);
+			if (Enter > Exit)
+			{
+				return false;
+			}
+		}
+
+		OutDistance = Enter;
+		return true;
+	}
+}
+
 UHandViewportMapperComponent::UHandViewportMapperComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
@@ -54,6 +113,9 @@ void UHandViewportMapperComponent::BeginPlay()
 		if (FM)
 		{
 			FM->OnGestureFrameReceived.AddDynamic(this, &UHandViewportMapperComponent::HandleGestureFrame);
+
+			// Only the pointing ray is used, so the tracker can leave out every other landmark.
+			LandmarkSubscription = FM->RegisterLandmarkSubscription({ PointerStartLandmark, PointerEndLandmark });
 		}
 	}
 
@@ -68,6 +130,22 @@ void UHandViewportMapperComponent::BeginPlay()
 	}
 }
 
+void UHandViewportMapperComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReleaseSlatePointers(0);
+
+	if (LandmarkSubscription != INDEX_NONE)
+	{
+		if (AFusionMode* FM = Cast<AFusionMode>(UGameplayStatics::GetGameMode(GetWorld())))
+		{
+			FM->UnregisterLandmarkSubscription(LandmarkSubscription);
+		}
+		LandmarkSubscription = INDEX_NONE;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UHandViewportMapperComponent::SetSourceQuad(const FFusionScreenQuad& InQuad)
 {
 	SourceQuad = InQuad;
@@ -147,52 +225,266 @@ bool UHandViewportMapperComponent::MapDirectionToViewport(const FFusionHandSnaps
 	return !OutDirection.IsNearlyZero();
 }
 
+bool UHandViewportMapperComponent::MakeHandRay(const FFusionHandSnapshot& Hand, int32 StartLandmarkId, int32 EndLandmarkId, float MaxDistance, FFusionWidgetRay& OutRay) const
+{
+	OutRay = FFusionWidgetRay();
+	if (!MapDirectionToViewport(Hand, StartLandmarkId, EndLandmarkId, OutRay.Origin, OutRay.Direction))
+	{
+		return false;
+	}
+
+	OutRay.MaxDistance = MaxDistance;
+	return true;
+}
+
 bool UHandViewportMapperComponent::FindWidgetAlongDirection(const FFusionHandSnapshot& Hand, int32 StartLandmarkId, int32 EndLandmarkId, float MaxDistance, FFusionWidgetHitResult& OutHitResult) const
 {
-	FVector2D Origin;
-	FVector2D Direction;
-	if (!MapDirectionToViewport(Hand, StartLandmarkId, EndLandmarkId, Origin, Direction))
+	FFusionWidgetRay Ray;
+	if (!MakeHandRay(Hand, StartLandmarkId, EndLandmarkId, MaxDistance, Ray))
 	{
 		return false;
 	}
 
-	const FVector2D NormalizedDirection = Direction.GetSafeNormal();
-	if (NormalizedDirection.IsNearlyZero())
+	FFusionWidgetHitResult HitResult = OutHitResult;
+	if (HitTestRays(MakeArrayView(&Ray, 1), MakeArrayView(&HitResult, 1)) == 0)
 	{
 		return false;
 	}
+
+	if (HitResult.Widget != OutHitResult.Widget)
+	{
+		OnSelect(false);
+	}
+	OutHitResult = HitResult;
+	OnSelect(true);
+	//UE_LOG(LogHandViewportMapper, Log, TEXT("Widget hit: %s at %s"), *OutHitResult.Widget->GetName(), *OutHitResult.ViewportPosition.ToString());
+	return true;
+}
+
+int32 UHandViewportMapperComponent::FindWidgetsAlongRays(const TArray<FFusionWidgetRay>& Rays, TArray<FFusionWidgetHitResult>& InOutHitResults) const
+{
+	InOutHitResults.SetNum(Rays.Num());
+	return HitTestRays(Rays, InOutHitResults);
+}
+
+int32 UHandViewportMapperComponent::HitTestRays(TConstArrayView<FFusionWidgetRay> Rays, TArrayView<FFusionWidgetHitResult> InOutHitResults) const
+{
+	check(Rays.Num() == InOutHitResults.Num());
+
+	UpdateInteractableIndex();
+
+	// Fast path first: each ray keeps the widget it hit last time while it stays within the hysteresis margin.
 	const float StepLength = FMath::Max(1.f, WidgetSearchStep);
-	const int32 StepCount = FMath::Max(1, WidgetSearchSamples > 0 ? WidgetSearchSamples : FMath::CeilToInt(MaxDistance / StepLength));
-	for (int32 StepIndex = 1; StepIndex <= StepCount; ++StepIndex)
+	RayScratch.Reset();
+	int32 NumSearching = 0;
+	for (int32 RayIndex = 0; RayIndex < Rays.Num(); ++RayIndex)
 	{
-		const float Distance = StepLength * StepIndex;
-		if (Distance > MaxDistance)
+		const FFusionWidgetRay& Ray = Rays[RayIndex];
+		FRayState& RayState = RayScratch.AddDefaulted_GetRef();
+		RayState.Direction = Ray.Direction.GetSafeNormal();
+		if (RayState.Direction.IsNearlyZero())
 		{
-			break;
+			continue;
 		}
 
-		const FVector2D SamplePoint = Origin + NormalizedDirection * Distance;
-		FFusionWidgetHitResult HitResult;
-		if (HitTestWidgetAt(SamplePoint, HitResult))
+		const int32 StepCount = FMath::Max(1, WidgetSearchSamples > 0 ? WidgetSearchSamples : FMath::CeilToInt(Ray.MaxDistance / StepLength));
+		RayState.Reach = FMath::Min(Ray.MaxDistance, StepLength * StepCount);
+
+		// The previous widget may have been destroyed since it was stored, so it is only looked up by address and then
+		// checked through the index entry's weak pointer, never dereferenced directly.
+		const int32* PreviousEntry = InteractableIndexByWidget.Find(InOutHitResults[RayIndex].Widget);
+		if (PreviousEntry)
 		{
-			if (Cast<UInteractableWidget>(HitResult.Widget))
+			const UInteractableWidget* Previous = InteractableIndex[*PreviousEntry].Widget.Get();
+			if (!Previous || !Previous->IsOnScreen())
 			{
-				if (HitResult.Widget != OutHitResult.Widget)
+				PreviousEntry = nullptr;
+			}
+		}
+		double Distance = 0.0;
+		if (PreviousEntry && IntersectRayBox(Ray.Origin, RayState.Direction, InteractableIndex[*PreviousEntry].Bounds.ExpandBy(WidgetHitHysteresis), RayState.Reach, Distance))
+		{
+			RayState.Coherent = &InteractableIndex[*PreviousEntry];
+			RayState.CoherentDistance = Distance;
+			continue;
+		}
+		++NumSearching;
+	}
+
+	// One pass over the index serves every ray that left its widget: the nearest entry point wins, and where rects
+	// overlap, the one painted on top. Skipped entirely when every ray stayed on its widget.
+	if (NumSearching > 0 && bUseWidgetIndex)
+	{
+		for (const FInteractableRect& Entry : InteractableIndex)
+		{
+			UInteractableWidget* Widget = Entry.Widget.Get();
+			if (!Widget || !Widget->IsOnScreen())
+			{
+				continue;
+			}
+
+			for (int32 RayIndex = 0; RayIndex < Rays.Num(); ++RayIndex)
+			{
+				FRayState& RayState = RayScratch[RayIndex];
+				double Distance = 0.0;
+				if (RayState.Coherent || RayState.Direction.IsNearlyZero()
+					|| !IntersectRayBox(Rays[RayIndex].Origin, RayState.Direction, Entry.Bounds, RayState.Reach, Distance))
+				{
+					continue;
+				}
+
+				const bool bCloser = !RayState.Best || Distance < RayState.BestDistance - UE_KINDA_SMALL_NUMBER;
+				const bool bOnTop = RayState.Best && FMath::IsNearlyEqual(Distance, RayState.BestDistance, UE_KINDA_SMALL_NUMBER) && Entry.LayerId > RayState.Best->LayerId;
+				if (bCloser || bOnTop)
 				{
-					OnSelect(false);
+					RayState.Best = &Entry;
+					RayState.BestDistance = Distance;
 				}
-				OutHitResult = HitResult;
-				OnSelect(true);
-				const FString WidgetLabel = OutHitResult.Widget->GetName();
-				//UE_LOG(LogHandViewportMapper, Log, TEXT("Widget hit: %s at %s"), *WidgetLabel, *OutHitResult.ViewportPosition.ToString());
-				return true;
 			}
 		}
 	}
 
+	int32 NumHits = 0;
+	for (int32 RayIndex = 0; RayIndex < Rays.Num(); ++RayIndex)
+	{
+		const FRayState& RayState = RayScratch[RayIndex];
+		const FVector2D& Origin = Rays[RayIndex].Origin;
+		FFusionWidgetHitResult& HitResult = InOutHitResults[RayIndex];
+		if (RayState.Direction.IsNearlyZero())
+		{
+			HitResult = FFusionWidgetHitResult();
+			continue;
+		}
+
+		++WidgetHitStats.Queries;
+		if (RayState.Coherent)
+		{
+			++WidgetHitStats.CoherentHits;
+			FillHitResult(*RayState.Coherent, Origin + RayState.Direction * RayState.CoherentDistance, HitResult);
+			++NumHits;
+			continue;
+		}
+
+		++WidgetHitStats.FullSearches;
+		bool bHit = false;
+		if (bUseWidgetIndex)
+		{
+			bHit = RayState.Best != nullptr;
+			if (bHit)
+			{
+				FillHitResult(*RayState.Best, Origin + RayState.Direction * RayState.BestDistance, HitResult);
+			}
+		}
+		else
+		{
+			bHit = MarchWidgetsAlongRay(Origin, RayState.Direction, StepLength, RayState.Reach, HitResult);
+		}
+
+		if (!bHit)
+		{
+			HitResult = FFusionWidgetHitResult();
+			continue;
+		}
+		++WidgetHitStats.FullSearchHits;
+		++NumHits;
+	}
+
+	return NumHits;
+}
+
+bool UHandViewportMapperComponent::MarchWidgetsAlongRay(const FVector2D& Origin, const FVector2D& Direction, float StepLength, float Reach, FFusionWidgetHitResult& OutHitResult) const
+{
+	const int32 StepCount = FMath::FloorToInt(Reach / StepLength);
+	for (int32 StepIndex = 1; StepIndex <= StepCount; ++StepIndex)
+	{
+		const float Distance = StepLength * StepIndex;
+		FFusionWidgetHitResult HitResult;
+		if (HitTestWidgetAt(Origin + Direction * Distance, HitResult) && Cast<UInteractableWidget>(HitResult.Widget))
+		{
+			OutHitResult = HitResult;
+			return true;
+		}
+	}
+
 	return false;
 }
 
+void UHandViewportMapperComponent::FillHitResult(const FInteractableRect& Entry, const FVector2D& ViewportPosition, FFusionWidgetHitResult& OutHitResult)
+{
+	OutHitResult = FFusionWidgetHitResult();
+	OutHitResult.Widget = Entry.Widget.Get();
+	OutHitResult.ViewportPosition = ViewportPosition;
+	OutHitResult.WidgetType = Entry.WidgetType;
+	OutHitResult.WidgetTag = Entry.WidgetTag;
+}
+
+FFusionWidgetHitStats UHandViewportMapperComponent::GetWidgetHitStats() const
+{
+	FFusionWidgetHitStats Result = WidgetHitStats;
+	Result.CoherentHitRate = Result.Queries > 0 ? static_cast<float>(Result.CoherentHits) / Result.Queries : 0.f;
+	Result.FullSearchHitRate = Result.FullSearches > 0 ? static_cast<float>(Result.FullSearchHits) / Result.FullSearches : 0.f;
+	return Result;
+}
+
+void UHandViewportMapperComponent::ResetWidgetHitStats()
+{
+	WidgetHitStats = FFusionWidgetHitStats();
+}
+
+void UHandViewportMapperComponent::UpdateInteractableIndex() const
+{
+	UWorld* World = GetWorld();
+	const UInteractableWidgetSubsystem* Registry = UWorld::GetSubsystem<UInteractableWidgetSubsystem>(World);
+	const uint32 LayoutVersion = Registry ? Registry->GetLayoutVersion() : 0;
+	if (LayoutVersion == IndexedLayoutVersion && IndexedWorld == World)
+	{
+		return;
+	}
+
+	// Reset keeps the allocations, so rebuilds after the first reuse them.
+	InteractableIndex.Reset();
+	InteractableIndexByWidget.Reset();
+	if (!Registry || !GEngine || !GEngine->GameViewport)
+	{
+		return;
+	}
+	IndexedLayoutVersion = LayoutVersion;
+	IndexedWorld = World;
+
+	// Widgets report desktop-space rects; the pointer ray lives in viewport space.
+	const FGeometry ViewportGeometry = UWidgetLayoutLibrary::GetViewportWidgetGeometry(World);
+	for (const TWeakObjectPtr<UInteractableWidget>& WeakWidget : Registry->GetWidgets())
+	{
+		UInteractableWidget* Widget = WeakWidget.Get();
+		if (!Widget || !Widget->IsOnScreen() || !UWidget::ConvertSerializedVisibilityToRuntime(Widget->GetVisibility()).IsHitTestVisible())
+		{
+			continue;
+		}
+
+		const TSharedPtr<SWidget> SlateWidget = Widget->GetCachedWidget();
+		if (!SlateWidget.IsValid())
+		{
+			continue;
+		}
+
+		const FSlateRect& AbsoluteRect = Widget->GetLastAbsoluteRect();
+		const FVector2D TopLeft = ViewportGeometry.AbsoluteToLocal(AbsoluteRect.GetTopLeft());
+		const FVector2D BottomRight = ViewportGeometry.AbsoluteToLocal(AbsoluteRect.GetBottomRight());
+		if (BottomRight.X <= TopLeft.X || BottomRight.Y <= TopLeft.Y)
+		{
+			continue;
+		}
+
+		FInteractableRect& Entry = InteractableIndex.AddDefaulted_GetRef();
+		Entry.Widget = Widget;
+		Entry.Bounds = FBox2D(TopLeft, BottomRight);
+		Entry.LayerId = SlateWidget->GetPersistentState().LayerId;
+		Entry.WidgetType = SlateWidget->GetType();
+		Entry.WidgetTag = SlateWidget->GetTag();
+		InteractableIndexByWidget.Add(Widget, InteractableIndex.Num() - 1);
+	}
+}
+
 bool UHandViewportMapperComponent::RebuildHomography()
 {
 	TArray<FVector2D> SourcePoints;
@@ -354,25 +646,7 @@ bool UHandViewportMapperComponent::ApplyHomography(const FVector2D& SourcePoint,
 
 bool UHandViewportMapperComponent::TryGetLandmarkLocation(const FFusionHandSnapshot& Hand, int32 LandmarkId, FVector& OutWorldLocation) const
 {
-	static constexpr int32 ComponentsPerLandmark = 3;
-
-	if (LandmarkId < 0)
-	{
-		return false;
-	}
-
-	const int32 BaseIndex = LandmarkId * ComponentsPerLandmark;
-	if (!Hand.x_y_z.IsValidIndex(BaseIndex) || !Hand.x_y_z.IsValidIndex(BaseIndex + 1))
-	{
-		return false;
-	}
-
-	const float X = Hand.x_y_z[BaseIndex];
-	const float Y = Hand.x_y_z[BaseIndex + 1];
-	const float Z = Hand.x_y_z.IsValidIndex(BaseIndex + 2) ? Hand.x_y_z[BaseIndex + 2] : 0.f;
-
-	OutWorldLocation = FVector(X, Y, Z);
-	return true;
+	return AFusionMode::GetHandLandmarkLocation(Hand, LandmarkId, OutWorldLocation);
 }
 
 bool UHandViewportMapperComponent::TryExtractHandLandmark(const FFusionHandSnapshot& Hand, int32 LandmarkId, FVector2D& OutViewportPoint) const
@@ -394,16 +668,13 @@ bool UHandViewportMapperComponent::TryExtractUWidget(const TSharedPtr<SWidget>&
 		return false;
 	}
 
-	if (SlateWidget->GetTypeAsString().Contains(TEXT("SObjectWidget")))
+	if (SlateWidget->GetType() != ObjectWidgetType)
 	{
-		if (TSharedPtr<SObjectWidget> ObjectWidget = StaticCastSharedPtr<SObjectWidget>(SlateWidget))
-		{
-			OutWidget = ObjectWidget->GetWidgetObject();
-			return OutWidget != nullptr;
-		}
+		return false;
 	}
 
-	return false;
+	OutWidget = StaticCastSharedPtr<SObjectWidget>(SlateWidget)->GetWidgetObject();
+	return OutWidget != nullptr;
 }
 
 bool UHandViewportMapperComponent::HitTestWidgetAt(const FVector2D& ViewportPosition, FFusionWidgetHitResult& OutHitResult) const
@@ -428,25 +699,16 @@ bool UHandViewportMapperComponent::HitTestWidgetAt(const FVector2D& ViewportPosi
 
 	for (int32 Index = WidgetPath.Widgets.Num() - 1; Index >= 0; --Index)
 	{
-		const FArrangedWidget& ArrangedWidget = WidgetPath.Widgets[Index];
-		if (TSharedPtr<SWidget> SlateWidget = ArrangedWidget.Widget)
+		const TSharedPtr<SWidget> SlateWidget = WidgetPath.Widgets[Index].Widget;
+		UWidget* Widget = nullptr;
+		const bool bHasObject = TryExtractUWidget(SlateWidget, Widget);
+		if (bHasObject || SlateWidget->GetTag() != NAME_None)
 		{
-			UWidget* Widget = nullptr;
-			OutHitResult.Widget = nullptr;
+			OutHitResult.Widget = Widget;
 			OutHitResult.ViewportPosition = ViewportPosition;
-			OutHitResult.WidgetType = SlateWidget->GetTypeAsString();
+			OutHitResult.WidgetType = SlateWidget->GetType();
 			OutHitResult.WidgetTag = SlateWidget->GetTag();
-
-			if (TryExtractUWidget(SlateWidget, Widget))
-			{
-				OutHitResult.Widget = Widget;
-				return true;
-			}
-
-			if (OutHitResult.WidgetTag != NAME_None)
-			{
-				return true;
-			}
+			return true;
 		}
 	}
 
@@ -472,22 +734,41 @@ FVector2D* UHandViewportMapperComponent::ResolveCorner(FFusionScreenQuad& Quad,
 
 void UHandViewportMapperComponent::HandleGestureFrame(const TArray<FFusionHandSnapshot>& Hands)
 {
-	if (Hands.Num() <= 0)
-		return;
-	if (Hands[0].x_y_z.Num() <= 0)
+	// Without a hand the Slate pointers would keep hovering, or keep a button down, until one comes back.
+	if (Hands.Num() <= 0 || Hands[0].x_y_z.Num() <= 0)
+	{
+		ReleaseSlatePointers(0);
 		return;
+	}
 	
 	FVector IndexFingerTip;
 	if (GEngine)
 	{
 		GEngine->AddOnScreenDebugMessage(1, 5.0f, FColor::Red, Hands[0].state);
-		GEngine->AddOnScreenDebugMessage(1, 5.0f, FColor::Red, FString::Printf(TEXT("%f, %f, %f"), Hands[0].x_y_z[24],Hands[0].x_y_z[25],Hands[0].x_y_z[26]));
+		FVector DebugTip;
+		if (TryGetLandmarkLocation(Hands[0], 8, DebugTip))
+		{
+			GEngine->AddOnScreenDebugMessage(1, 5.0f, FColor::Red, FString::Printf(TEXT("%f, %f, %f"), DebugTip.X, DebugTip.Y, DebugTip.Z));
+		}
 		
 	}
+
+	// Ahead of the gesture handling below so "select" reaches Slate as a press.
+	if (bRouteHandsThroughSlate && State == EFusionState::World)
+	{
+		RouteHandsThroughSlate(Hands);
+	}
+	else
+	{
+		ReleaseSlatePointers(0);
+	}
+
 	if (Hands[0].state.Equals("select"))
 	{
+		// A press some widget handled in Slate is that widget's click; only unhandled ones reach the game.
+		const bool bHandledBySlate = SlatePointers.Num() > 0 && SlatePointers[0].bPressHandled;
 		APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
-		if (PC)
+		if (PC && !bHandledBySlate)
 		{
 			AFusionPlayerController* FPC = Cast<AFusionPlayerController>(PC);
 			if (FPC)
@@ -540,7 +821,10 @@ void UHandViewportMapperComponent::HandleGestureFrame(const TArray<FFusionHandSn
 		
 		break;
 		case EFusionState::World:
-		FindWidgetAlongDirection(Hands[0], 7,8,1920, WidgetHit);
+		if (!bRouteHandsThroughSlate)
+		{
+			UpdateHandPointers(Hands);
+		}
 		break;
 		case EFusionState::Description:
 		
@@ -548,6 +832,158 @@ void UHandViewportMapperComponent::HandleGestureFrame(const TArray<FFusionHandSn
 	}
 }
 
+void UHandViewportMapperComponent::UpdateHandPointers(const TArray<FFusionHandSnapshot>& Hands)
+{
+	// Each hand's last hit follows it by handedness, so hysteresis survives the tracker reordering hands. Hands
+	// without handedness fall back to their position in the frame.
+	Swap(HandWidgetHits, PreviousHandWidgetHits);
+	Swap(HandKeys, PreviousHandKeys);
+	HandRays.SetNum(Hands.Num());
+	HandWidgetHits.SetNum(Hands.Num());
+	HandKeys.SetNum(Hands.Num());
+	for (int32 HandIndex = 0; HandIndex < Hands.Num(); ++HandIndex)
+	{
+		const FFusionHandSnapshot& Hand = Hands[HandIndex];
+		const int32 PreviousIndex = Hand.Handedness.IsEmpty()
+			? (PreviousHandKeys.IsValidIndex(HandIndex) && PreviousHandKeys[HandIndex].IsEmpty() ? HandIndex : INDEX_NONE)
+			: PreviousHandKeys.IndexOfByKey(Hand.Handedness);
+		HandWidgetHits[HandIndex] = PreviousIndex != INDEX_NONE ? PreviousHandWidgetHits[PreviousIndex] : FFusionWidgetHitResult();
+		HandKeys[HandIndex] = Hand.Handedness;
+		MakeHandRay(Hand, PointerStartLandmark, PointerEndLandmark, 1920.f, HandRays[HandIndex]);
+	}
+	HitTestRays(HandRays, HandWidgetHits);
+
+	// The first hand owns WidgetHit, which clicks act on and which stays put while that hand points at nothing.
+	if (HandWidgetHits[0].Widget)
+	{
+		WidgetHit = HandWidgetHits[0];
+	}
+
+	// Every hand hovers what it points at.
+	TArray<TWeakObjectPtr<UInteractableWidget>, TInlineAllocator<4>> Hovered;
+	if (UInteractableWidget* Primary = Cast<UInteractableWidget>(WidgetHit.Widget))
+	{
+		Hovered.AddUnique(Primary);
+	}
+	for (int32 HandIndex = 1; HandIndex < HandWidgetHits.Num(); ++HandIndex)
+	{
+		if (UInteractableWidget* Widget = Cast<UInteractableWidget>(HandWidgetHits[HandIndex].Widget))
+		{
+			Hovered.AddUnique(Widget);
+		}
+	}
+
+	for (const TWeakObjectPtr<UInteractableWidget>& Widget : HoveredWidgets)
+	{
+		if (Widget.IsValid() && !Hovered.Contains(Widget))
+		{
+			Widget->OnSelecting(false);
+		}
+	}
+	for (const TWeakObjectPtr<UInteractableWidget>& Widget : Hovered)
+	{
+		if (!HoveredWidgets.Contains(Widget))
+		{
+			Widget->OnSelecting(true);
+		}
+	}
+	HoveredWidgets.Reset();
+	HoveredWidgets.Append(Hovered);
+}
+
+void UHandViewportMapperComponent::RouteHandsThroughSlate(const TArray<FFusionHandSnapshot>& Hands)
+{
+	if (!FSlateApplication::IsInitialized() || !GetWorld())
+	{
+		return;
+	}
+
+	FSlateApplication& SlateApplication = FSlateApplication::Get();
+	const FGeometry ViewportGeometry = UWidgetLayoutLibrary::GetViewportWidgetGeometry(GetWorld());
+
+	ReleaseSlatePointers(Hands.Num());
+	for (int32 HandIndex = 0; HandIndex < Hands.Num(); ++HandIndex)
+	{
+		if (!SlatePointers.IsValidIndex(HandIndex))
+		{
+			SlatePointers.AddDefaulted_GetRef().User = SlateApplication.FindOrCreateVirtualUser(FirstHandVirtualUser + HandIndex);
+		}
+		FSlateHandPointer& Pointer = SlatePointers[HandIndex];
+
+		// A hand without its pointing landmarks this frame leaves its pointer where it was.
+		FVector2D Origin;
+		FVector2D Direction;
+		if (!MapDirectionToViewport(Hands[HandIndex], PointerStartLandmark, PointerEndLandmark, Origin, Direction))
+		{
+			continue;
+		}
+
+		const FVector2D PointerPosition = Origin + Direction + Direction.GetSafeNormal() * SlatePointerOffset;
+		const FVector2D ScreenPosition = ViewportGeometry.LocalToAbsolute(PointerPosition);
+		const int32 UserIndex = Pointer.User->GetUserIndex();
+		SlateApplication.ProcessMouseMoveEvent(MakeHandPointerEvent(UserIndex, ScreenPosition, Pointer.ScreenPosition, Pointer.bPressed, FKey()));
+
+		const bool bPressed = Hands[HandIndex].state.Equals("select");
+		if (bPressed != Pointer.bPressed)
+		{
+			const FPointerEvent ButtonEvent = MakeHandPointerEvent(UserIndex, ScreenPosition, ScreenPosition, bPressed, EKeys::LeftMouseButton);
+			if (bPressed)
+			{
+				Pointer.bPressHandled = SlateApplication.ProcessMouseButtonDownEvent(nullptr, ButtonEvent);
+			}
+			else
+			{
+				SlateApplication.ProcessMouseButtonUpEvent(ButtonEvent);
+				Pointer.bPressHandled = false;
+			}
+			Pointer.bPressed = bPressed;
+		}
+		Pointer.ScreenPosition = ScreenPosition;
+	}
+
+	// Clicks from the player controller act on WidgetHit, so it follows what the first hand hovers, as in ray mode.
+	const UInteractableWidgetSubsystem* Registry = UWorld::GetSubsystem<UInteractableWidgetSubsystem>(GetWorld());
+	if (!Registry)
+	{
+		return;
+	}
+
+	const int32 PrimaryUser = SlatePointers[0].User->GetUserIndex();
+	for (const TWeakObjectPtr<UInteractableWidget>& Widget : Registry->GetWidgets())
+	{
+		if (Widget.IsValid() && Widget->IsHoveredByUser(PrimaryUser))
+		{
+			WidgetHit = FFusionWidgetHitResult();
+			WidgetHit.Widget = Widget.Get();
+			WidgetHit.ViewportPosition = ViewportGeometry.AbsoluteToLocal(SlatePointers[0].ScreenPosition);
+			break;
+		}
+	}
+}
+
+void UHandViewportMapperComponent::ReleaseSlatePointers(int32 NumToKeep)
+{
+	if (!FSlateApplication::IsInitialized())
+	{
+		SlatePointers.SetNum(FMath::Min(SlatePointers.Num(), NumToKeep));
+		return;
+	}
+
+	// Releasing the button and moving off every window gives widgets their up and leave events before the user goes.
+	FSlateApplication& SlateApplication = FSlateApplication::Get();
+	while (SlatePointers.Num() > NumToKeep)
+	{
+		const FSlateHandPointer& Pointer = SlatePointers.Last();
+		const int32 UserIndex = Pointer.User->GetUserIndex();
+		if (Pointer.bPressed)
+		{
+			SlateApplication.ProcessMouseButtonUpEvent(MakeHandPointerEvent(UserIndex, Pointer.ScreenPosition, Pointer.ScreenPosition, false, EKeys::LeftMouseButton));
+		}
+		SlateApplication.ProcessMouseMoveEvent(MakeHandPointerEvent(UserIndex, OffscreenPointerPosition, Pointer.ScreenPosition, false, FKey()));
+		SlatePointers.Pop();
+	}
+}
+
 void UHandViewportMapperComponent::OnSelect(bool bIsSelecting) const
 {
 	UInteractableWidget* iw = Cast<UInteractableWidget>(WidgetHit.Widget);
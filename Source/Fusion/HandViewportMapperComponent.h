@@ -6,6 +6,8 @@
 #include "HandViewportMapperComponent.generated.h"
 
 class UWidget;
+class UInteractableWidget;
+class FSlateVirtualUserHandle;
 
 USTRUCT(BlueprintType)
 struct FFusionScreenQuad
@@ -64,13 +66,57 @@ struct FFusionWidgetHitResult
 	UPROPERTY(BlueprintReadOnly, Category="Fusion|UI")
 	FVector2D ViewportPosition = FVector2D::ZeroVector;
 
+	/** Slate type of the hit widget, e.g. SObjectWidget; a name so filling it in never allocates. */
 	UPROPERTY(BlueprintReadOnly, Category="Fusion|UI")
-	FString WidgetType;
+	FName WidgetType = NAME_None;
 
 	UPROPERTY(BlueprintReadOnly, Category="Fusion|UI")
 	FName WidgetTag = NAME_None;
 };
 
+USTRUCT(BlueprintType)
+struct FFusionWidgetHitStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="Fusion|UI")
+	int32 Queries = 0;
+
+	/** Queries answered by the previously hit widget, within the hysteresis margin. */
+	UPROPERTY(BlueprintReadOnly, Category="Fusion|UI")
+	int32 CoherentHits = 0;
+
+	/** Queries that fell back to the full search, and how many of those found a widget. */
+	UPROPERTY(BlueprintReadOnly, Category="Fusion|UI")
+	int32 FullSearches = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Fusion|UI")
+	int32 FullSearchHits = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Fusion|UI")
+	float CoherentHitRate = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category="Fusion|UI")
+	float FullSearchHitRate = 0.f;
+};
+
+/** A pointing ray in viewport space, e.g. from MakeHandRay. */
+USTRUCT(BlueprintType)
+struct FFusionWidgetRay
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Fusion|UI")
+	FVector2D Origin = FVector2D::ZeroVector;
+
+	/** Need not be normalized; a zero direction never hits. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Fusion|UI")
+	FVector2D Direction = FVector2D::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Fusion|UI")
+	float MaxDistance = 1920.f;
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStateChanged, EFusionState, State);
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
@@ -105,9 +151,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Fusion|Mapping")
 	bool MapDirectionToViewport(const FFusionHandSnapshot& Hand, int32 StartLandmarkId, int32 EndLandmarkId, FVector2D& OutOrigin, FVector2D& OutDirection) const;
 
+	UFUNCTION(BlueprintCallable, Category="Fusion|Mapping")
+	bool MakeHandRay(const FFusionHandSnapshot& Hand, int32 StartLandmarkId, int32 EndLandmarkId, float MaxDistance, FFusionWidgetRay& OutRay) const;
+
 	UFUNCTION(BlueprintCallable, Category="Fusion|Mapping")
 	bool FindWidgetAlongDirection(const FFusionHandSnapshot& Hand, int32 StartLandmarkId, int32 EndLandmarkId, float MaxDistance, FFusionWidgetHitResult& OutHitResult) const;
 
+	/**
+	 * Hit-tests all rays in one pass over the widget index and returns how many hit. InOutHitResults gets one result
+	 * per ray, Widget null on a miss; passing last call's results back in lets each ray keep its widget within
+	 * WidgetHitHysteresis.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Fusion|Mapping")
+	int32 FindWidgetsAlongRays(const TArray<FFusionWidgetRay>& Rays, UPARAM(ref) TArray<FFusionWidgetHitResult>& InOutHitResults) const;
+
+	UFUNCTION(BlueprintCallable, Category="Fusion|Mapping")
+	FFusionWidgetHitStats GetWidgetHitStats() const;
+
+	UFUNCTION(BlueprintCallable, Category="Fusion|Mapping")
+	void ResetWidgetHitStats();
+
 	UFUNCTION(BlueprintCallable, Category="Fusion|Calibration")
 	void AutoSetTargetQuadFromViewport();
 
@@ -116,8 +179,11 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
+	friend struct FHandViewportMapperTestAccess;
+
 	bool RebuildHomography();
 	bool ComputeHomography(const TArray<FVector2D>& SourcePoints, const TArray<FVector2D>& TargetPoints);
 	bool SolveLinearSystem8x8(double A[8][8], double B[8], double X[8]) const;
@@ -126,6 +192,12 @@ private:
 	bool TryExtractHandLandmark(const FFusionHandSnapshot& Hand, int32 LandmarkId, FVector2D& OutViewportPoint) const;
 	bool TryExtractUWidget(const TSharedPtr<SWidget>& SlateWidget, UWidget*& OutWidget) const;
 	bool HitTestWidgetAt(const FVector2D& ViewportPosition, FFusionWidgetHitResult& OutHitResult) const;
+	bool MarchWidgetsAlongRay(const FVector2D& Origin, const FVector2D& Direction, float StepLength, float Reach, FFusionWidgetHitResult& OutHitResult) const;
+	int32 HitTestRays(TConstArrayView<FFusionWidgetRay> Rays, TArrayView<FFusionWidgetHitResult> InOutHitResults) const;
+	void UpdateInteractableIndex() const;
+	void UpdateHandPointers(const TArray<FFusionHandSnapshot>& Hands);
+	void RouteHandsThroughSlate(const TArray<FFusionHandSnapshot>& Hands);
+	void ReleaseSlatePointers(int32 NumToKeep);
 	FVector2D* ResolveCorner(FFusionScreenQuad& Quad, EFusionScreenQuadCorner Corner);
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Fusion|Calibration", meta=(AllowPrivateAccess="true"))
@@ -143,11 +215,91 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Fusion|Mapping", meta=(ClampMin="1.0", AllowPrivateAccess="true"))
 	int32 WidgetSearchSamples = 32;
 
+	/** Intersects the ray with cached interactable widget rects instead of hit-testing Slate at every search step. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Fusion|Mapping", meta=(AllowPrivateAccess="true"))
+	bool bUseWidgetIndex = true;
+
+	/**
+	 * Moves a Slate virtual user to each tracked hand's fingertip instead of ray-testing widgets, so Slate resolves
+	 * hover and clicks ("select" presses the left button) and standard UMG events such as OnHovered and OnClicked
+	 * fire. A press no widget handles falls through to the usual select action. Hovering follows that point rather
+	 * than the whole pointing ray; pointers leave when their hand is lost or the mapper leaves the World state.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Fusion|Mapping", meta=(AllowPrivateAccess="true"))
+	bool bRouteHandsThroughSlate = false;
+
+	/** How far past the fingertip along the pointing ray the Slate pointer sits, in viewport pixels. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Fusion|Mapping", meta=(AllowPrivateAccess="true"))
+	float SlatePointerOffset = 0.f;
+
+	/** The widget hit last time keeps the pointer while the ray passes within this many viewport pixels of it. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Fusion|Mapping", meta=(ClampMin="0.0", AllowPrivateAccess="true"))
+	float WidgetHitHysteresis = 16.f;
+
 	double Homography[9];
 	bool bHasValidHomography;
 
 	EFusionState State = EFusionState::World;
 
+	/** Index finger PIP and tip; the pointing ray runs from the first through the second. */
+	static constexpr int32 PointerStartLandmark = 7;
+	static constexpr int32 PointerEndLandmark = 8;
+
+	int32 LandmarkSubscription = INDEX_NONE;
+
+	/** Viewport-space rect of an on-screen interactable widget, rebuilt when UInteractableWidget's layout version moves. */
+	struct FInteractableRect
+	{
+		TWeakObjectPtr<UInteractableWidget> Widget;
+		FBox2D Bounds;
+		int32 LayerId = 0;
+		FName WidgetType;
+		FName WidgetTag;
+	};
+
+	mutable TArray<FInteractableRect> InteractableIndex;
+	/** Keyed by address only; hit results may still hold widgets that were destroyed since. */
+	mutable TMap<const UWidget*, int32> InteractableIndexByWidget;
+	mutable uint32 IndexedLayoutVersion = 0;
+	mutable TWeakObjectPtr<UWorld> IndexedWorld;
+
+	/** Per-ray working state of HitTestRays, kept between calls so steady frames do not allocate. */
+	struct FRayState
+	{
+		FVector2D Direction = FVector2D::ZeroVector;
+		double Reach = 0.0;
+		const FInteractableRect* Coherent = nullptr;
+		double CoherentDistance = 0.0;
+		const FInteractableRect* Best = nullptr;
+		double BestDistance = 0.0;
+	};
+
+	mutable TArray<FRayState> RayScratch;
+	mutable FFusionWidgetHitStats WidgetHitStats;
+
+	/** One pointing ray, hit and handedness per tracked hand, last frame's hits, and the widgets hovered now. */
+	TArray<FFusionWidgetRay> HandRays;
+	TArray<FFusionWidgetHitResult> HandWidgetHits;
+	TArray<FFusionWidgetHitResult> PreviousHandWidgetHits;
+	TArray<FString> HandKeys;
+	TArray<FString> PreviousHandKeys;
+	TArray<TWeakObjectPtr<UInteractableWidget>> HoveredWidgets;
+
+	struct FSlateHandPointer
+	{
+		TSharedPtr<FSlateVirtualUserHandle> User;
+		FVector2D ScreenPosition = FVector2D::ZeroVector;
+		bool bPressed = false;
+
+		/** Whether a widget handled the current press, in which case "select" does not also click in the game. */
+		bool bPressHandled = false;
+	};
+
+	/** One Slate virtual user per tracked hand while bRouteHandsThroughSlate is on. */
+	TArray<FSlateHandPointer> SlatePointers;
+
+	static void FillHitResult(const FInteractableRect& Entry, const FVector2D& ViewportPosition, FFusionWidgetHitResult& OutHitResult);
+
 	UFUNCTION()
 	void HandleGestureFrame(const TArray<FFusionHandSnapshot>& Hands);
 
@@ -0,0 +1,173 @@
+#include "HandViewportMapperComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include <atomic>
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformTLS.h"
+#include "InteractableWidget.h"
+#include "InteractableWidgetSubsystem.h"
+#include "Misc/AutomationTest.h"
+
+/** Reaches the private hit-test entry point and widget index, which the test fills without a game viewport. */
+struct FHandViewportMapperTestAccess
+{
+	static int32 HitTestRays(const UHandViewportMapperComponent& Mapper, TConstArrayView<FFusionWidgetRay> Rays, TArrayView<FFusionWidgetHitResult> InOutHitResults)
+	{
+		return Mapper.HitTestRays(Rays, InOutHitResults);
+	}
+
+	/** Replaces the index with the given viewport rects and marks it current, so UpdateInteractableIndex keeps it. */
+	static void SetIndex(const UHandViewportMapperComponent& Mapper, TConstArrayView<TPair<UInteractableWidget*, FBox2D>> Rects)
+	{
+		UWorld* World = Mapper.GetWorld();
+		const UInteractableWidgetSubsystem* Registry = UWorld::GetSubsystem<UInteractableWidgetSubsystem>(World);
+		Mapper.IndexedWorld = World;
+		Mapper.IndexedLayoutVersion = Registry ? Registry->GetLayoutVersion() : 0;
+
+		Mapper.InteractableIndex.Reset();
+		Mapper.InteractableIndexByWidget.Reset();
+		for (const TPair<UInteractableWidget*, FBox2D>& Rect : Rects)
+		{
+			// Slate never ticks these widgets, so they are marked as painted this frame by hand.
+			Rect.Key->LastTickFrame = GFrameCounter;
+
+			UHandViewportMapperComponent::FInteractableRect& Entry = Mapper.InteractableIndex.AddDefaulted_GetRef();
+			Entry.Widget = Rect.Key;
+			Entry.Bounds = Rect.Value;
+			Mapper.InteractableIndexByWidget.Add(Rect.Key, Mapper.InteractableIndex.Num() - 1);
+		}
+	}
+};
+
+namespace
+{
+	/** Forwards to the real allocator and counts the allocations made on the thread that started counting. */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		void Begin(FMalloc* InInner)
+		{
+			Inner = InInner;
+			ThreadId = FPlatformTLS::GetCurrentThreadId();
+			NumAllocations = 0;
+		}
+
+		int32 GetNumAllocations() const { return NumAllocations.load(); }
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void MarkTLSCachesAsUsedOnCurrentThread() override { Inner->MarkTLSCachesAsUsedOnCurrentThread(); }
+		virtual void MarkTLSCachesAsUnusedOnCurrentThread() override { Inner->MarkTLSCachesAsUnusedOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("FusionCountingMalloc"); }
+
+	private:
+		void CountAllocation()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+			{
+				++NumAllocations;
+			}
+		}
+
+		FMalloc* Inner = nullptr;
+		uint32 ThreadId = 0;
+		std::atomic<int32> NumAllocations{ 0 };
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHandViewportMapperHitTestAllocationTest, "Fusion.HandViewportMapper.HitTestRaysDoesNotAllocate",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FHandViewportMapperHitTestAllocationTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	AActor* Owner = World->SpawnActor<AActor>();
+	UHandViewportMapperComponent* Mapper = NewObject<UHandViewportMapperComponent>(Owner);
+
+	// Two widgets stacked on the left and one further right, in viewport pixels.
+	UInteractableWidget* Upper = NewObject<UInteractableWidget>(World);
+	UInteractableWidget* Lower = NewObject<UInteractableWidget>(World);
+	UInteractableWidget* Right = NewObject<UInteractableWidget>(World);
+	const TPair<UInteractableWidget*, FBox2D> Rects[] =
+	{
+		{ Upper, FBox2D(FVector2D(400.f, 100.f), FVector2D(600.f, 300.f)) },
+		{ Lower, FBox2D(FVector2D(400.f, 700.f), FVector2D(600.f, 900.f)) },
+		{ Right, FBox2D(FVector2D(1000.f, 400.f), FVector2D(1200.f, 600.f)) },
+	};
+	FHandViewportMapperTestAccess::SetIndex(*Mapper, Rects);
+
+	// Rays 0 and 1 stay on their widgets (coherent path), ray 2 jumps between widgets every frame (full search hit),
+	// ray 3 points past everything (full search miss) and ray 4 is degenerate.
+	TArray<FFusionWidgetRay> Rays;
+	Rays.SetNum(5);
+	Rays[0].Origin = FVector2D(200.f, 150.f);
+	Rays[1].Origin = FVector2D(200.f, 750.f);
+	Rays[3].Origin = FVector2D(200.f, 1000.f);
+	for (int32 RayIndex = 0; RayIndex < 4; ++RayIndex)
+	{
+		Rays[RayIndex].Direction = FVector2D(1.f, 0.f);
+	}
+	auto AimJumpingRay = [&Rays](int32 Frame)
+	{
+		Rays[2].Origin = Frame % 2 == 0 ? FVector2D(800.f, 500.f) : FVector2D(200.f, 250.f);
+	};
+	TArray<FFusionWidgetHitResult> HitResults;
+	HitResults.SetNum(Rays.Num());
+
+	// The first call sizes the per-ray scratch; steady frames after it must only reuse it.
+	AimJumpingRay(1);
+	FHandViewportMapperTestAccess::HitTestRays(*Mapper, Rays, HitResults);
+	Mapper->ResetWidgetHitStats();
+
+	// Installed for the measured frames only and counting the test thread alone. The swap is atomic and the proxy is
+	// never destroyed, so other threads allocating meanwhile go through either allocator safely.
+	constexpr int32 NumFrames = 16;
+	static FCountingMalloc CountingMalloc;
+	CountingMalloc.Begin(GMalloc);
+	FMalloc* const RealMalloc = static_cast<FMalloc*>(FPlatformAtomics::InterlockedExchangePtr(reinterpret_cast<void**>(&GMalloc), &CountingMalloc));
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Rays[0].Origin.Y += 4.f;
+		Rays[1].Origin.Y += 4.f;
+		AimJumpingRay(Frame);
+		FHandViewportMapperTestAccess::HitTestRays(*Mapper, Rays, HitResults);
+	}
+	FPlatformAtomics::InterlockedExchangePtr(reinterpret_cast<void**>(&GMalloc), RealMalloc);
+
+	const FFusionWidgetHitStats Stats = Mapper->GetWidgetHitStats();
+	TestEqual(TEXT("Coherent hits of the rays that stayed on their widgets"), Stats.CoherentHits, 2 * NumFrames);
+	TestEqual(TEXT("Full-search hits of the ray jumping between widgets"), Stats.FullSearchHits, NumFrames);
+	TestEqual(TEXT("Full searches, including the ray that misses"), Stats.FullSearches, 2 * NumFrames);
+	TestTrue(TEXT("Jumping ray ends on the upper widget"), HitResults[2].Widget == Upper);
+	TestEqual(TEXT("Allocations in steady-state HitTestRays"), CountingMalloc.GetNumAllocations(), 0);
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
@@ -2,14 +2,31 @@
 
 
 #include "InteractableWidget.h"
+#include "InteractableWidgetSubsystem.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Application/SlateUser.h"
 #include "Huxley/AnimalActor.h"
 #include "Huxley/CameraManager.h"
 #include "Huxley/FusionPlayerController.h"
 #include "Kismet/GameplayStatics.h"
 
+namespace
+{
+	bool IsHandPointer(const FPointerEvent& MouseEvent)
+	{
+		const TSharedPtr<FSlateUser> User = FSlateApplication::Get().GetUser(MouseEvent.GetUserIndex());
+		return User.IsValid() && User->IsVirtualUser();
+	}
+}
+
 void UInteractableWidget::NativeConstruct()
 {
 	Super::NativeConstruct();
+
+	if (UInteractableWidgetSubsystem* Registry = UWorld::GetSubsystem<UInteractableWidgetSubsystem>(GetWorld()))
+	{
+		Registry->RegisterWidget(this);
+	}
 	
 	TArray<AActor*> MyActors;
 	UGameplayStatics::GetAllActorsOfClassWithTag(GetWorld(), AAnimalActor::StaticClass(), AnimalName, MyActors);
@@ -26,6 +43,59 @@ void UInteractableWidget::OnSelecting(bool bIsSelecting)
 	}
 }
 
+void UInteractableWidget::NativeDestruct()
+{
+	if (UInteractableWidgetSubsystem* Registry = UWorld::GetSubsystem<UInteractableWidgetSubsystem>(GetWorld()))
+	{
+		Registry->UnregisterWidget(this);
+	}
+	LastTickFrame = 0;
+	HoveringHandUsers.Empty();
+
+	Super::NativeDestruct();
+}
+
+void UInteractableWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	// Compared every frame so indices only rebuild on real layout changes; a widget that was not ticking last frame
+	// has just been shown again.
+	const FSlateRect AbsoluteRect = MyGeometry.GetLayoutBoundingRect();
+	const ESlateVisibility CurrentVisibility = GetVisibility();
+	if (!IsOnScreen() || AbsoluteRect != LastAbsoluteRect || CurrentVisibility != LastVisibility)
+	{
+		LastAbsoluteRect = AbsoluteRect;
+		LastVisibility = CurrentVisibility;
+		if (UInteractableWidgetSubsystem* Registry = UWorld::GetSubsystem<UInteractableWidgetSubsystem>(GetWorld()))
+		{
+			Registry->MarkLayoutChanged();
+		}
+	}
+	LastTickFrame = GFrameCounter;
+}
+
+void UInteractableWidget::NativeOnMouseEnter(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+	Super::NativeOnMouseEnter(InGeometry, InMouseEvent);
+
+	if (IsHandPointer(InMouseEvent))
+	{
+		HoveringHandUsers.AddUnique(InMouseEvent.GetUserIndex());
+		OnSelecting(true);
+	}
+}
+
+void UInteractableWidget::NativeOnMouseLeave(const FPointerEvent& InMouseEvent)
+{
+	Super::NativeOnMouseLeave(InMouseEvent);
+
+	if (HoveringHandUsers.Remove(InMouseEvent.GetUserIndex()) > 0 && HoveringHandUsers.Num() == 0)
+	{
+		OnSelecting(false);
+	}
+}
+
 AAnimalActor* UInteractableWidget::OnInteract(bool bIsInteract)
 {
 	if (Animal)
@@ -22,9 +22,31 @@ class FUSION_API UInteractableWidget : public UUserWidget
 	TObjectPtr<AAnimalActor> Animal;
 
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual void NativeOnMouseEnter(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+	virtual void NativeOnMouseLeave(const FPointerEvent& InMouseEvent) override;
+
+	/** Slate virtual users (hand pointers) currently over this widget; the real mouse does not select. */
+	TArray<int32> HoveringHandUsers;
+
+	/** Desktop-space layout rect and visibility from the last tick, and the frame of that tick. */
+	FSlateRect LastAbsoluteRect;
+	ESlateVisibility LastVisibility = ESlateVisibility::Visible;
+	uint64 LastTickFrame = 0;
+
+	friend struct FHandViewportMapperTestAccess;
+
 public:
 	UFUNCTION()
 	void OnSelecting(bool bIsSelecting);
 	UFUNCTION()
 	AAnimalActor* OnInteract(bool bIsInteract);
+
+	/** Slate only ticks widgets it paints, so one that stopped ticking is hidden, collapsed or off screen. */
+	bool IsOnScreen() const { return LastTickFrame + 2 >= GFrameCounter; }
+
+	const FSlateRect& GetLastAbsoluteRect() const { return LastAbsoluteRect; }
+
+	bool IsHoveredByUser(int32 UserIndex) const { return HoveringHandUsers.Contains(UserIndex); }
 };
@@ -0,0 +1,17 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "InteractableWidgetSubsystem.h"
+#include "InteractableWidget.h"
+
+void UInteractableWidgetSubsystem::RegisterWidget(UInteractableWidget* Widget)
+{
+	Widgets.AddUnique(Widget);
+	++LayoutVersion;
+}
+
+void UInteractableWidgetSubsystem::UnregisterWidget(UInteractableWidget* Widget)
+{
+	Widgets.RemoveAllSwap([Widget](const TWeakObjectPtr<UInteractableWidget>& Registered) { return !Registered.IsValid() || Registered.Get() == Widget; });
+	++LayoutVersion;
+}
@@ -0,0 +1,34 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InteractableWidgetSubsystem.generated.h"
+
+class UInteractableWidget;
+
+/**
+ * Constructed interactable widgets of one world, for hit-test indices such as the hand pointer's.
+ */
+UCLASS()
+class FUSION_API UInteractableWidgetSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterWidget(UInteractableWidget* Widget);
+	void UnregisterWidget(UInteractableWidget* Widget);
+
+	/** Called by a registered widget that moved, resized, changed visibility or came back on screen. */
+	void MarkLayoutChanged() { ++LayoutVersion; }
+
+	const TArray<TWeakObjectPtr<UInteractableWidget>>& GetWidgets() const { return Widgets; }
+
+	/** Changes whenever a widget of this world is added, removed or changes its layout. */
+	uint32 GetLayoutVersion() const { return LayoutVersion; }
+
+private:
+	TArray<TWeakObjectPtr<UInteractableWidget>> Widgets;
+	uint32 LayoutVersion = 0;
+};
@@ -32,6 +32,7 @@ void UCaptionWidget::NativeConstruct()
 		if (FM)
 		{
 			FM->OnVoiceAnswerReceived.AddDynamic(this, &UCaptionWidget::EnterCaption);
+			FM->OnVoiceAnswerChunkReceived.AddDynamic(this, &UCaptionWidget::AppendCaption);
 		}
 	}
 	
@@ -139,6 +140,9 @@ void UCaptionWidget::InitializeTextBlock(UTextBlock* _TextBlock)
 
 void UCaptionWidget::EnterCaption(const FString& Q, const FString& A)
 {
+	bIsStreamingAnswer = false;
+	StreamedAnswer.Reset();
+
 	Txt_Q->SetVisibility(ESlateVisibility::Visible);
 	Txt_A->SetVisibility(ESlateVisibility::Visible);
 
@@ -154,9 +158,33 @@ void UCaptionWidget::EnterCaption(const FString& Q, const FString& A)
 	// }
 }
 
+void UCaptionWidget::AppendCaption(const FString& Q, const FString& Chunk)
+{
+	if (!bIsStreamingAnswer)
+	{
+		// 첫 토큰: 이전 답변을 지우고 자막을 띄운다
+		bIsStreamingAnswer = true;
+		StreamedAnswer.Reset();
+
+		Txt_Q->SetVisibility(ESlateVisibility::Visible);
+		Txt_A->SetVisibility(ESlateVisibility::Visible);
+		Txt_A->SetText(FText::GetEmpty());
+	}
+
+	Txt_Q->SetText(FText::FromString(Q));
+
+	if (!Chunk.IsEmpty())
+	{
+		StreamedAnswer.Append(Chunk);
+		Txt_A->SetText(FText::FromString(StreamedAnswer));
+	}
+}
+
 void UCaptionWidget::ExitCaption()
 {
 	GetWorld()->GetTimerManager().ClearTimer(TypingTimerHandle);
+	bIsStreamingAnswer = false;
+	StreamedAnswer.Reset();
 	
 	if (SlideOut)
 	{
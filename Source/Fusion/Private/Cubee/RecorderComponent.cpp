@@ -2,10 +2,12 @@
 
 
 #include "Cubee/RecorderComponent.h"
+#include "Async/Async.h"
 #include "HAL/FileManager.h"
 #include "Http.h"
 #include "HttpModule.h"
 #include "Fusion/FusionMode.h"
+#include "Fusion/FusionRequestTelemetry.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Kismet/GameplayStatics.h"
@@ -53,6 +55,11 @@ void URecorderComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 		}
 	}
 
+	if (ActiveUploadTiming.IsValid())
+	{
+		FFusionRequestTelemetry::Get().RecordAbandoned(*ActiveUploadTiming);
+		ActiveUploadTiming.Reset();
+	}
 	ActiveUploadRequest.Reset();
 
 	Super::EndPlay(EndPlayReason);
@@ -65,18 +72,73 @@ void URecorderComponent::HandleCaptureBuffer(const float* AudioData, int32 NumSa
 		return;
 	}
 
+	const uint64 CallbackStartCycles = FPlatformTime::Cycles64();
 	FScopeLock Lock(&DataCriticalSection);
+	const uint64 LockAcquiredCycles = FPlatformTime::Cycles64();
+
+	const double LockWaitMicros = FPlatformTime::ToSeconds64(LockAcquiredCycles - CallbackStartCycles) * 1e6;
+	++CaptureStats.CallbackCount;
+	CaptureStats.TotalLockWaitMicros += LockWaitMicros;
+	CaptureStats.MaxLockWaitMicros = FMath::Max(CaptureStats.MaxLockWaitMicros, static_cast<float>(LockWaitMicros));
+
 	if (!bIsRecording)
 	{
+		CaptureStats.SamplesDiscarded += NumSamples;
 		return;
 	}
 
-	PCMData.Reserve(PCMData.Num() + NumSamples);
+	// Reserve(Num + N) 는 콜백마다 정확한 크기로 재할당하므로, AddUninitialized 의 기하급수 증가에 맡긴다
+	const int32 PreviousMax = PCMData.Max();
+	const int32 WriteIndex = PCMData.AddUninitialized(NumSamples);
+	if (PCMData.Max() != PreviousMax)
+	{
+		CaptureStats.BytesAllocated += static_cast<int64>(PCMData.Max()) * sizeof(int16);
+	}
+
+	int16* Destination = PCMData.GetData() + WriteIndex;
 	for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
 	{
 		const float Clamped = FMath::Clamp(AudioData[SampleIndex], -1.0f, 1.0f);
-		PCMData.Add(static_cast<int16>(Clamped * 32767.0f));
+		Destination[SampleIndex] = static_cast<int16>(Clamped * 32767.0f);
 	}
+	CaptureStats.SamplesCaptured += NumSamples;
+
+	const float CallbackMicros = static_cast<float>(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - CallbackStartCycles) * 1e6);
+	CaptureStats.MaxCallbackMicros = FMath::Max(CaptureStats.MaxCallbackMicros, CallbackMicros);
+}
+
+void URecorderComponent::BeginCapture(int32 SampleRate, int32 NumChannels)
+{
+	FScopeLock Lock(&DataCriticalSection);
+	PCMData.Reset();
+	CachedSampleRate = SampleRate;
+	CachedNumChannels = NumChannels;
+	bIsRecording = true;
+}
+
+bool URecorderComponent::TakeCapturedAudio(TArray<int16>& OutPCMData, int32& OutSampleRate, int32& OutNumChannels)
+{
+	FScopeLock Lock(&DataCriticalSection);
+	const bool bWasRecording = bIsRecording;
+
+	bIsRecording = false;
+	OutPCMData = MoveTemp(PCMData);
+	OutSampleRate = CachedSampleRate;
+	OutNumChannels = CachedNumChannels;
+
+	return bWasRecording || OutPCMData.Num() > 0;
+}
+
+FRecorderCaptureStats URecorderComponent::GetCaptureStats() const
+{
+	FScopeLock Lock(&DataCriticalSection);
+	return CaptureStats;
+}
+
+void URecorderComponent::ResetCaptureStats()
+{
+	FScopeLock Lock(&DataCriticalSection);
+	CaptureStats = FRecorderCaptureStats();
 }
 
 bool URecorderComponent::EnsureAudioCaptureInitialized()
@@ -124,11 +186,7 @@ void URecorderComponent::StartRecording()
 		return;
 	}
 
-	FScopeLock Lock(&DataCriticalSection);
-	PCMData.Reset();
-	CachedSampleRate = AudioCapture ? AudioCapture->GetSampleRate() : 0;
-	CachedNumChannels = AudioCapture ? AudioCapture->GetNumChannels() : 0;
-	bIsRecording = true;
+	BeginCapture(AudioCapture ? AudioCapture->GetSampleRate() : 0, AudioCapture ? AudioCapture->GetNumChannels() : 0);
 
 	if (AudioCapture && !AudioCapture->IsCapturingAudio())
 	{
@@ -147,17 +205,9 @@ void URecorderComponent::StopRecordingAndSave(const FString& FilePath)
 	int32 SampleRate = 0;
 	int32 NumChannels = 0;
 
+	if (!TakeCapturedAudio(LocalPCMData, SampleRate, NumChannels))
 	{
-		FScopeLock Lock(&DataCriticalSection);
-		if (!bIsRecording && PCMData.Num() == 0)
-		{
-			UE_LOG(LogMyClass, Warning, TEXT("StopRecordingAndSave called without active recording or captured data."));
-		}
-
-		bIsRecording = false;
-		LocalPCMData = PCMData;
-		SampleRate = CachedSampleRate;
-		NumChannels = CachedNumChannels;
+		UE_LOG(LogMyClass, Warning, TEXT("StopRecordingAndSave called without active recording or captured data."));
 	}
 
 	if (LocalPCMData.Num() == 0 || SampleRate <= 0 || NumChannels <= 0)
@@ -182,15 +232,43 @@ void URecorderComponent::StopRecordingAndSave(const FString& FilePath)
 		ResolvedPath.Append(TEXT(".wav"));
 	}
 
-	if (!WriteWavFile(ResolvedPath, LocalPCMData, SampleRate, NumChannels))
+	// 인코딩과 디스크 쓰기는 워커에서 처리하고, 결과만 게임 스레드로 돌려보낸다
+	TWeakObjectPtr<URecorderComponent> WeakThis = this;
+	LastSaveTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis, ResolvedPath, LocalPCMData = MoveTemp(LocalPCMData), SampleRate, NumChannels]() mutable
+		{
+			TArray<uint8> WavData;
+			BuildWavData(LocalPCMData, SampleRate, NumChannels, WavData);
+			LocalPCMData.Empty();
+
+			const bool bSaved = WriteWavFile(ResolvedPath, WavData);
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, bSaved, ResolvedPath, WavData = MoveTemp(WavData)]() mutable
+			{
+				if (URecorderComponent* StrongThis = WeakThis.Get())
+				{
+					StrongThis->HandleRecordingSaved(bSaved, ResolvedPath, MoveTemp(WavData));
+				}
+			});
+		},
+		UE::Tasks::Prerequisites(LastSaveTask));
+}
+
+void URecorderComponent::HandleRecordingSaved(bool bSaved, const FString& FilePath, TArray<uint8>&& WavData)
+{
+	OnVoiceRecordingSaved.Broadcast(bSaved, FilePath);
+
+	if (!bSaved)
 	{
-		UE_LOG(LogMyClass, Error, TEXT("Failed to write wav file: %s"), *ResolvedPath);
+		UE_LOG(LogMyClass, Error, TEXT("Failed to write wav file: %s"), *FilePath);
 		OnVoiceUploadCompleted.Broadcast(false, 0, TEXT("Failed to write wav file"));
 		return;
 	}
 
-	UE_LOG(LogMyClass, Log, TEXT("Saved wav file to %s"), *ResolvedPath);
-	UploadWavFile(ResolvedPath);
+	UE_LOG(LogMyClass, Log, TEXT("Saved wav file to %s"), *FilePath);
+
+	// 방금 인코딩한 버퍼를 그대로 업로드해 파일을 다시 읽지 않는다
+	UploadWavData(FilePath, MoveTemp(WavData));
 }
 
 void URecorderComponent::UploadWavFile(const FString& FilePath)
@@ -210,16 +288,19 @@ void URecorderComponent::UploadWavFile(const FString& FilePath)
 		return;
 	}
 
-	UE_LOG(LogMyClass, Log, TEXT("Uploading wav file (%d bytes) to %s"), FileData.Num(), *VoiceUploadEndpoint);
+	UploadWavData(FilePath, MoveTemp(FileData));
+}
 
-	AGameModeBase* GM = UGameplayStatics::GetGameMode(GetWorld());
+void URecorderComponent::UploadWavData(const FString& FilePath, TArray<uint8>&& WavData)
+{
+	UE_LOG(LogMyClass, Log, TEXT("Uploading wav file %s (%d bytes) to %s"), *FilePath, WavData.Num(), *VoiceUploadEndpoint);
 
-	if (GM)
+	if (AFusionMode* FM = Cast<AFusionMode>(UGameplayStatics::GetGameMode(GetWorld())))
 	{
-		AFusionMode* FM = Cast<AFusionMode>(GM);
-		FM->SendVoiceQuery(FilePath);
+		FM->SendVoiceQueryData(MoveTemp(WavData));
 		return;
 	}
+
 	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
 	Request->SetURL(VoiceUploadEndpoint);
 	Request->SetVerb(TEXT("POST"));
@@ -229,22 +310,28 @@ void URecorderComponent::UploadWavFile(const FString& FilePath)
 		Request->SetHeader(TEXT("Authorization"), ApiToken);
 	}
 
-	Request->SetContent(MoveTemp(FileData));
+	Request->SetContent(MoveTemp(WavData));
 	Request->OnProcessRequestComplete().BindUObject(this, &URecorderComponent::OnUploadCompleted);
+
+	// 이전 업로드는 계속 진행되지만 더 이상 추적하지 않으므로, 덮어쓰기 전에 중단된 것으로 기록한다
+	if (ActiveUploadTiming.IsValid())
+	{
+		FFusionRequestTelemetry::Get().RecordAbandoned(*ActiveUploadTiming);
+	}
+	ActiveUploadTiming = FFusionRequestTelemetry::Track(Request);
 	ActiveUploadRequest = Request;
 	Request->ProcessRequest();
 }
 
-bool URecorderComponent::WriteWavFile(const FString& FilePath, const TArray<int16>& InPCMData, int32 SampleRate,
-	int32 NumChannels) const
+void URecorderComponent::BuildWavData(const TArray<int16>& InPCMData, int32 SampleRate, int32 NumChannels, TArray<uint8>& OutWavData)
 {
 	const int32 NumAudioBytes = InPCMData.Num() * sizeof(int16);
 	const uint16 BitsPerSample = 16;
 	const uint16 BlockAlign = NumChannels * (BitsPerSample / 8);
 	const uint32 ByteRate = SampleRate * BlockAlign;
 
-	TArray<uint8> WavData;
-	WavData.Reserve(44 + NumAudioBytes);
+	TArray<uint8>& WavData = OutWavData;
+	WavData.Reset(44 + NumAudioBytes);
 
 	auto AppendAnsi = [&WavData](const ANSICHAR* Text, int32 Length)
 	{
@@ -284,7 +371,10 @@ bool URecorderComponent::WriteWavFile(const FString& FilePath, const TArray<int1
 
 	const uint8* PCMBytes = reinterpret_cast<const uint8*>(InPCMData.GetData());
 	WavData.Append(PCMBytes, NumAudioBytes);
+}
 
+bool URecorderComponent::WriteWavFile(const FString& FilePath, const TArray<uint8>& WavData)
+{
 	const FString Directory = FPaths::GetPath(FilePath);
 	if (!Directory.IsEmpty())
 	{
@@ -296,9 +386,16 @@ bool URecorderComponent::WriteWavFile(const FString& FilePath, const TArray<int1
 
 void URecorderComponent::OnUploadCompleted(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
-	ActiveUploadRequest.Reset();
-
-	ActiveUploadRequest.Reset();
+	// 나중에 시작된 업로드가 있으면 그 타이밍을 이 응답으로 닫지 않는다
+	if (Request == ActiveUploadRequest)
+	{
+		ActiveUploadRequest.Reset();
+		if (ActiveUploadTiming.IsValid())
+		{
+			FFusionRequestTelemetry::Get().RecordCompleted(*ActiveUploadTiming, Response);
+			ActiveUploadTiming.Reset();
+		}
+	}
 
 	const int32 StatusCode = Response.IsValid() ? Response->GetResponseCode() : 0;
 	const FString ResponseContent = Response.IsValid() ? Response->GetContentAsString() : FString();
@@ -0,0 +1,257 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Cubee/RecorderComponent.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include <atomic>
+
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Thread.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Parse.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogRecorderStress, Log, All);
+
+// 합성 오디오 스레드로 HandleCaptureBuffer 를 실시간(또는 그 이상) 속도로 밀어 넣고,
+// 다른 스레드에서 녹음 종료/WAV 인코딩 사이클을 돌리면서 콜백 경로가 버티는지 측정한다.
+// 사용법: Fusion.Recorder.StressTest Seconds=10 SampleRate=48000 Channels=2 Frames=1024 Speed=1 FinalizeInterval=2
+class FRecorderStressTest
+{
+public:
+	struct FSettings
+	{
+		float Seconds = 10.f;
+		int32 SampleRate = 48000;
+		int32 NumChannels = 2;
+		int32 FramesPerBuffer = 1024;
+		// 1 = 실시간, 2 = 두 배속, 0 = 대기 없이 최대 속도
+		float Speed = 1.f;
+		float FinalizeInterval = 2.f;
+	};
+
+	static void Run(const TArray<FString>& Args)
+	{
+		bool bExpected = false;
+		if (!bRunning.compare_exchange_strong(bExpected, true))
+		{
+			UE_LOG(LogRecorderStress, Warning, TEXT("Recorder stress test is already running."));
+			return;
+		}
+
+		FSettings Settings;
+		GConfig->GetInt(TEXT("/Script/WindowsTargetPlatform.WindowsTargetSettings"), TEXT("AudioCallbackBufferFrameSize"), Settings.FramesPerBuffer, GEngineIni);
+		GConfig->GetInt(TEXT("/Script/WindowsTargetPlatform.WindowsTargetSettings"), TEXT("AudioSampleRate"), Settings.SampleRate, GEngineIni);
+
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Seconds="), Settings.Seconds);
+			FParse::Value(*Arg, TEXT("SampleRate="), Settings.SampleRate);
+			FParse::Value(*Arg, TEXT("Channels="), Settings.NumChannels);
+			FParse::Value(*Arg, TEXT("Frames="), Settings.FramesPerBuffer);
+			FParse::Value(*Arg, TEXT("Speed="), Settings.Speed);
+			FParse::Value(*Arg, TEXT("FinalizeInterval="), Settings.FinalizeInterval);
+		}
+
+		Settings.Seconds = FMath::Max(0.1f, Settings.Seconds);
+		Settings.SampleRate = FMath::Max(1, Settings.SampleRate);
+		Settings.NumChannels = FMath::Max(1, Settings.NumChannels);
+		Settings.FramesPerBuffer = FMath::Max(1, Settings.FramesPerBuffer);
+		Settings.Speed = FMath::Max(0.f, Settings.Speed);
+		Settings.FinalizeInterval = FMath::Max(0.01f, Settings.FinalizeInterval);
+
+		URecorderComponent* Recorder = NewObject<URecorderComponent>(GetTransientPackage());
+		Recorder->AddToRoot();
+
+		UE_LOG(LogRecorderStress, Log, TEXT("Starting recorder stress test: %.1fs, %d Hz x %d ch, %d frames/buffer, speed %.2f, finalize every %.2fs"),
+			Settings.Seconds, Settings.SampleRate, Settings.NumChannels, Settings.FramesPerBuffer, Settings.Speed, Settings.FinalizeInterval);
+
+		// 작업 스레드 풀을 점유하면 측정 대상인 인코딩/업로드 작업이 밀리므로 전용 스레드에서 조율한다
+		Coordinator = MakeUnique<FThread>(TEXT("RecorderStressCoordinator"), [Recorder, Settings]()
+		{
+			Execute(*Recorder, Settings);
+
+			AsyncTask(ENamedThreads::GameThread, [Recorder]()
+			{
+				Coordinator->Join();
+				Coordinator.Reset();
+				Recorder->RemoveFromRoot();
+				bRunning = false;
+			});
+		});
+	}
+
+	/** 호출한 스레드에서 끝날 때까지 실행하고 결과를 로그로 남긴다. 버려진 샘플 수를 돌려준다. */
+	static int64 Execute(URecorderComponent& Recorder, const FSettings& Settings)
+	{
+		const int32 SamplesPerBuffer = Settings.FramesPerBuffer * Settings.NumChannels;
+		const double BufferPeriodSeconds = static_cast<double>(Settings.FramesPerBuffer) / Settings.SampleRate;
+
+		Recorder.ResetCaptureStats();
+		Recorder.BeginCapture(Settings.SampleRate, Settings.NumChannels);
+
+		std::atomic<bool> bProducerDone = false;
+		int64 SamplesProduced = 0;
+		int64 LateBuffers = 0;
+		uint64 WorstCallbackCycles = 0;
+
+		int64 SamplesFinalized = 0;
+		int64 FinalizeCount = 0;
+		int64 WavBytesAllocated = 0;
+		uint64 WorstFinalizeCycles = 0;
+
+		const double StartSeconds = FPlatformTime::Seconds();
+
+		FThread Producer(TEXT("RecorderStressProducer"), [&]()
+		{
+			TArray<float> Buffer;
+			Buffer.SetNumUninitialized(SamplesPerBuffer);
+
+			int64 BufferIndex = 0;
+			double Phase = 0.0;
+			const double PhaseStep = 2.0 * PI * 440.0 / Settings.SampleRate;
+
+			while (FPlatformTime::Seconds() - StartSeconds < Settings.Seconds)
+			{
+				for (int32 Frame = 0; Frame < Settings.FramesPerBuffer; ++Frame)
+				{
+					const float Sample = static_cast<float>(FMath::Sin(Phase)) * 0.5f;
+					Phase += PhaseStep;
+					for (int32 Channel = 0; Channel < Settings.NumChannels; ++Channel)
+					{
+						Buffer[Frame * Settings.NumChannels + Channel] = Sample;
+					}
+				}
+
+				const uint64 CallbackStart = FPlatformTime::Cycles64();
+				Recorder.HandleCaptureBuffer(Buffer.GetData(), SamplesPerBuffer);
+				WorstCallbackCycles = FMath::Max(WorstCallbackCycles, FPlatformTime::Cycles64() - CallbackStart);
+
+				SamplesProduced += SamplesPerBuffer;
+				++BufferIndex;
+
+				if (Settings.Speed <= 0.f)
+				{
+					continue;
+				}
+
+				// 오디오 장치처럼 버퍼 주기에 맞춰 다음 콜백 시각까지 대기한다
+				const double Deadline = StartSeconds + BufferIndex * BufferPeriodSeconds / Settings.Speed;
+				const double Now = FPlatformTime::Seconds();
+				if (Now > Deadline + BufferPeriodSeconds / Settings.Speed)
+				{
+					++LateBuffers;
+				}
+				else if (Deadline > Now)
+				{
+					FPlatformProcess::SleepNoStats(static_cast<float>(Deadline - Now));
+				}
+			}
+
+			bProducerDone = true;
+		}, 0, TPri_TimeCritical);
+
+		FThread Finalizer(TEXT("RecorderStressFinalizer"), [&]()
+		{
+			TArray<int16> TakenPCM;
+			TArray<uint8> WavData;
+			int32 SampleRate = 0;
+			int32 NumChannels = 0;
+
+			auto FinalizeOnce = [&]()
+			{
+				const uint64 FinalizeStart = FPlatformTime::Cycles64();
+				Recorder.TakeCapturedAudio(TakenPCM, SampleRate, NumChannels);
+				SamplesFinalized += TakenPCM.Num();
+
+				URecorderComponent::BuildWavData(TakenPCM, SampleRate, NumChannels, WavData);
+				WavBytesAllocated += WavData.Max();
+				WavData.Empty();
+				TakenPCM.Empty();
+
+				WorstFinalizeCycles = FMath::Max(WorstFinalizeCycles, FPlatformTime::Cycles64() - FinalizeStart);
+				++FinalizeCount;
+			};
+
+			double NextFinalize = StartSeconds + Settings.FinalizeInterval;
+			while (!bProducerDone)
+			{
+				if (FPlatformTime::Seconds() >= NextFinalize)
+				{
+					FinalizeOnce();
+					Recorder.BeginCapture(Settings.SampleRate, Settings.NumChannels);
+					NextFinalize += Settings.FinalizeInterval;
+				}
+				FPlatformProcess::SleepNoStats(0.001f);
+			}
+
+			FinalizeOnce();
+		});
+
+		Producer.Join();
+		Finalizer.Join();
+
+		const double ElapsedSeconds = FMath::Max(FPlatformTime::Seconds() - StartSeconds, UE_SMALL_NUMBER);
+		const FRecorderCaptureStats Stats = Recorder.GetCaptureStats();
+		const int64 DroppedSamples = SamplesProduced - SamplesFinalized;
+		const double AverageLockWaitMicros = Stats.CallbackCount > 0 ? Stats.TotalLockWaitMicros / Stats.CallbackCount : 0.0;
+
+		UE_LOG(LogRecorderStress, Log, TEXT("Recorder stress test finished in %.2fs (%.2fx realtime)"),
+			ElapsedSeconds, SamplesProduced / (static_cast<double>(Settings.SampleRate) * Settings.NumChannels) / ElapsedSeconds);
+		UE_LOG(LogRecorderStress, Log, TEXT("  samples: produced=%lld finalized=%lld dropped=%lld (discarded while stopped=%lld), late buffers=%lld"),
+			SamplesProduced, SamplesFinalized, DroppedSamples, Stats.SamplesDiscarded, LateBuffers);
+		UE_LOG(LogRecorderStress, Log, TEXT("  callback: count=%lld worst=%.1fus (measured in component=%.1fus), buffer period=%.1fus"),
+			Stats.CallbackCount, FPlatformTime::ToSeconds64(WorstCallbackCycles) * 1e6, Stats.MaxCallbackMicros, BufferPeriodSeconds * 1e6);
+		UE_LOG(LogRecorderStress, Log, TEXT("  lock wait: avg=%.2fus worst=%.1fus total=%.1fms"),
+			AverageLockWaitMicros, Stats.MaxLockWaitMicros, Stats.TotalLockWaitMicros / 1000.0);
+		UE_LOG(LogRecorderStress, Log, TEXT("  finalize: cycles=%lld worst=%.2fms"),
+			FinalizeCount, FPlatformTime::ToSeconds64(WorstFinalizeCycles) * 1000.0);
+		UE_LOG(LogRecorderStress, Log, TEXT("  allocations: %.1f KB/s (pcm growth=%lld B, wav=%lld B)"),
+			(Stats.BytesAllocated + WavBytesAllocated) / 1024.0 / ElapsedSeconds, Stats.BytesAllocated, WavBytesAllocated);
+
+		return DroppedSamples;
+	}
+
+private:
+	static std::atomic<bool> bRunning;
+	static TUniquePtr<FThread> Coordinator;
+};
+
+std::atomic<bool> FRecorderStressTest::bRunning = false;
+TUniquePtr<FThread> FRecorderStressTest::Coordinator;
+
+static FAutoConsoleCommand GRecorderStressTestCommand(
+	TEXT("Fusion.Recorder.StressTest"),
+	TEXT("Drives URecorderComponent's capture callback from a synthetic high-priority thread while finalizing on another. ")
+	TEXT("Args: Seconds= SampleRate= Channels= Frames= Speed= FinalizeInterval="),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&FRecorderStressTest::Run));
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+// 콘솔 명령과 같은 하네스를 짧게, 대기 없이 최대 속도로 돌려 녹음 중 종료/재시작 사이에 샘플이 사라지지 않는지 확인한다
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRecorderCaptureStressTest, "Fusion.Recorder.CaptureStress",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRecorderCaptureStressTest::RunTest(const FString& Parameters)
+{
+	FRecorderStressTest::FSettings Settings;
+	Settings.Seconds = 1.f;
+	Settings.Speed = 0.f;
+	Settings.FinalizeInterval = 0.1f;
+
+	URecorderComponent* Recorder = NewObject<URecorderComponent>(GetTransientPackage());
+	const int64 DroppedSamples = FRecorderStressTest::Execute(*Recorder, Settings);
+
+	TestTrue(TEXT("Capture callbacks ran"), Recorder->GetCaptureStats().CallbackCount > 0);
+	TestEqual(TEXT("Samples lost between finalize cycles"), DroppedSamples, static_cast<int64>(0));
+	return true;
+}
+
+#endif
+
+#endif
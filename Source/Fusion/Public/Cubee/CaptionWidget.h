@@ -63,6 +63,9 @@ public:
 protected:
 	bool bIsQuestion = false;
 
+	bool bIsStreamingAnswer = false;
+	FString StreamedAnswer;
+
 	// 지금까지 출력된 텍스트 & 인덱스
 	FString CurrentText;
 	int32 CurrentIndex;
@@ -87,6 +90,10 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void EnterCaption(const FString& Q, const FString& A);
 
+	// 스트리밍 응답: 토큰이 도착할 때마다 Txt_A 에 이어 붙인다
+	UFUNCTION(BlueprintCallable)
+	void AppendCaption(const FString& Q, const FString& Chunk);
+
 	UFUNCTION(BlueprintCallable)
 	void ExitCaption();
 
@@ -8,12 +8,47 @@
 #include "HttpFwd.h"
 #include "AudioCapture.h"
 #include "Generators/AudioGenerator.h"
+#include "Tasks/Task.h"
 #include "RecorderComponent.generated.h"
 
+struct FFusionRequestTiming;
+
 class IHttpRequest;
 class IHttpResponse;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnVoiceUploadCompleted, bool, bWasSuccessful, int32, StatusCode, const FString&, ResponseContent);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnVoiceRecordingSaved, bool, bWasSuccessful, const FString&, FilePath);
+
+// 오디오 콜백 경로 계측값 (스트레스 하네스와 디버그용)
+USTRUCT(BlueprintType)
+struct FRecorderCaptureStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="Voice Recording")
+	int64 CallbackCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Voice Recording")
+	int64 SamplesCaptured = 0;
+
+	// 녹음 중이 아닐 때 들어와 버려진 샘플 수
+	UPROPERTY(BlueprintReadOnly, Category="Voice Recording")
+	int64 SamplesDiscarded = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Voice Recording")
+	float MaxCallbackMicros = 0.f;
+
+	// 콜백마다 누적되므로 float 로는 긴 세션에서 작은 대기가 반올림되어 사라진다
+	UPROPERTY(BlueprintReadOnly, Category="Voice Recording")
+	double TotalLockWaitMicros = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Voice Recording")
+	float MaxLockWaitMicros = 0.f;
+
+	// PCM 버퍼 재할당으로 새로 잡힌 바이트 수
+	UPROPERTY(BlueprintReadOnly, Category="Voice Recording")
+	int64 BytesAllocated = 0;
+};
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class FUSION_API URecorderComponent : public UActorComponent
@@ -27,12 +62,19 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void StartRecording();
 
+	// 녹음 종료 후 WAV 인코딩/저장은 백그라운드 태스크에서 처리되고, 완료 시 게임 스레드에서 OnVoiceRecordingSaved 가 호출된다
 	UFUNCTION(BlueprintCallable)
 	void StopRecordingAndSave(const FString& FilePath);
 
 	UFUNCTION(BlueprintCallable)
 	void UploadWavFile(const FString& FilePath);
 
+	UFUNCTION(BlueprintCallable, Category="Voice Recording")
+	FRecorderCaptureStats GetCaptureStats() const;
+
+	UFUNCTION(BlueprintCallable, Category="Voice Recording")
+	void ResetCaptureStats();
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Voice Recording")
 	FString VoiceUploadEndpoint;
 
@@ -42,23 +84,43 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="Voice Recording")
 	FOnVoiceUploadCompleted OnVoiceUploadCompleted;
 
+	UPROPERTY(BlueprintAssignable, Category="Voice Recording")
+	FOnVoiceRecordingSaved OnVoiceRecordingSaved;
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
+	friend class FRecorderStressTest;
+
 	void HandleCaptureBuffer(const float* AudioData, int32 NumSamples);
 	bool EnsureAudioCaptureInitialized();
 
-	bool WriteWavFile(const FString& FilePath, const TArray<int16>& InPCMData, int32 SampleRate, int32 NumChannels) const;
+	// 락 안에서만 상태를 바꾸므로 오디오 스레드 외의 스레드에서도 호출 가능
+	void BeginCapture(int32 SampleRate, int32 NumChannels);
+	bool TakeCapturedAudio(TArray<int16>& OutPCMData, int32& OutSampleRate, int32& OutNumChannels);
+
+	static void BuildWavData(const TArray<int16>& InPCMData, int32 SampleRate, int32 NumChannels, TArray<uint8>& OutWavData);
+	static bool WriteWavFile(const FString& FilePath, const TArray<uint8>& WavData);
+	void HandleRecordingSaved(bool bSaved, const FString& FilePath, TArray<uint8>&& WavData);
+	void UploadWavData(const FString& FilePath, TArray<uint8>&& WavData);
 	void OnUploadCompleted(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
 
 	TArray<int16> PCMData;
 	int32 CachedSampleRate;
 	int32 CachedNumChannels;
 	bool bIsRecording;
-	FCriticalSection DataCriticalSection;
+	mutable FCriticalSection DataCriticalSection;
 	TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> ActiveUploadRequest;
+	// 직접 업로드할 때의 구간별 시간, FFusionRequestTelemetry 로 집계
+	TSharedPtr<FFusionRequestTiming> ActiveUploadTiming;
+
+	// DataCriticalSection 으로 보호
+	FRecorderCaptureStats CaptureStats;
+
+	// 이전 저장 태스크를 선행 조건으로 걸어 같은 파일에 대한 저장이 순서대로 실행되도록 한다
+	UE::Tasks::FTask LastSaveTask;
 
 	UPROPERTY()
 	UAudioCapture* AudioCapture;